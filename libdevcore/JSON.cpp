@@ -21,8 +21,10 @@
 
 #include <libdevcore/JSON.h>
 
+#include <libdevcore/Assertions.h>
 #include <libdevcore/CommonIO.h>
 
+#include <algorithm>
 #include <sstream>
 #include <map>
 #include <memory>
@@ -118,5 +120,79 @@ bool jsonParseFile(string const& _fileName, Json::Value& _json, string *_errs /*
 	return jsonParse(readFileAsString(_fileName), _json, _errs);
 }
 
+bool JsonStreamWriter::canWrite(vector<string> const& _path) const
+{
+	if (m_finished || _path.empty())
+		return false;
+	if (!m_started)
+		return true;
+	// The new member must not be inside the previous one.
+	if (m_lastPath.size() <= _path.size() && equal(m_lastPath.begin(), m_lastPath.end(), _path.begin()))
+		return false;
+	return m_lastPath < _path;
+}
+
+void JsonStreamWriter::write(vector<string> const& _path, Json::Value const& _value)
+{
+	writeSerialized(_path, jsonCompactPrint(_value));
+}
+
+void JsonStreamWriter::writeSerialized(vector<string> const& _path, string const& _value)
+{
+	assertThrow(canWrite(_path), JsonStreamWriterError, "Members have to be written in order.");
+
+	// The new state is only taken over once the member has been written.
+	string text;
+	vector<string> openObjects = m_openObjects;
+	vector<bool> hasMembers = m_hasMembers;
+	if (!m_started)
+	{
+		text += '{';
+		hasMembers.push_back(false);
+	}
+
+	size_t common = 0;
+	while (common < openObjects.size() && common + 1 < _path.size() && openObjects[common] == _path[common])
+		++common;
+	for (; openObjects.size() > common; openObjects.pop_back(), hasMembers.pop_back())
+		text += '}';
+	for (; openObjects.size() + 1 < _path.size(); hasMembers.push_back(false))
+	{
+		openObjects.push_back(_path[openObjects.size()]);
+		appendKey(text, hasMembers.back(), openObjects.back());
+		text += '{';
+	}
+	appendKey(text, hasMembers.back(), _path.back());
+	text += _value;
+	m_stream << text;
+
+	m_started = true;
+	m_openObjects = std::move(openObjects);
+	m_hasMembers = std::move(hasMembers);
+	m_lastPath = _path;
+}
+
+void JsonStreamWriter::finish()
+{
+	assertThrow(!m_finished, JsonStreamWriterError, "Already finished.");
+	string text;
+	if (!m_started)
+		text += '{';
+	text += string(m_openObjects.size() + 1, '}');
+	m_stream << text;
+
+	m_openObjects.clear();
+	m_hasMembers.clear();
+	m_finished = true;
+}
+
+void JsonStreamWriter::appendKey(string& _text, vector<bool>::reference _hasMembers, string const& _key)
+{
+	if (_hasMembers)
+		_text += ',';
+	_hasMembers = true;
+	// Print the key as a JSON string to get the same escaping.
+	_text += jsonCompactPrint(Json::Value(_key)) + ':';
+}
 
 } // namespace dev
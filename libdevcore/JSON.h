@@ -22,9 +22,13 @@
 
 #pragma once
 
+#include <libdevcore/Exceptions.h>
+
 #include <json/json.h>
 
+#include <ostream>
 #include <string>
+#include <vector>
 
 namespace dev {
 
@@ -55,4 +59,48 @@ bool jsonParse(std::string const& _input, Json::Value& _json, std::string* _errs
 /// \return \c true if the document was successfully parsed, \c false if an error occurred.
 bool jsonParseFile(std::string const& _fileName, Json::Value& _json, std::string* _errs = nullptr);
 
+DEV_SIMPLE_EXCEPTION(JsonStreamWriterError);
+
+/**
+ * Writes a JSON object to a stream member by member, without building the whole object
+ * in memory. The output is the same as the one of jsonCompactPrint() for the complete object.
+ *
+ * Members are specified by their path of object keys and have to be written in the order
+ * in which JSON objects print their members, i.e. sorted by their paths.
+ *
+ * Every member is written to the stream at once. If writing fails with an exception,
+ * the writer is left unchanged, so that the object can still be completed.
+ */
+class JsonStreamWriter
+{
+public:
+	explicit JsonStreamWriter(std::ostream& _stream): m_stream(_stream) {}
+
+	/// @returns true if a member at @a _path can still be written.
+	bool canWrite(std::vector<std::string> const& _path) const;
+	/// Writes the member at @a _path, creating the enclosing objects as needed.
+	void write(std::vector<std::string> const& _path, Json::Value const& _value);
+	/// Writes the member at @a _path, given as the output of jsonCompactPrint().
+	void writeSerialized(std::vector<std::string> const& _path, std::string const& _value);
+	/// Closes all open objects. Has to be called once after all members have been written.
+	void finish();
+	/// @returns true if finish() has been called.
+	bool finished() const { return m_finished; }
+
+private:
+	/// Appends @a _key to @a _text as the key of the next member of an object that already
+	/// has members if @a _hasMembers is set, and sets it.
+	static void appendKey(std::string& _text, std::vector<bool>::reference _hasMembers, std::string const& _key);
+
+	std::ostream& m_stream;
+	bool m_started = false;
+	bool m_finished = false;
+	/// Path of the last written member.
+	std::vector<std::string> m_lastPath;
+	/// Keys of the currently open objects below the root.
+	std::vector<std::string> m_openObjects;
+	/// Whether the root and the open objects already have members, innermost last.
+	std::vector<bool> m_hasMembers;
+};
+
 }
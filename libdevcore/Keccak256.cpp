@@ -21,10 +21,12 @@
 
 #include <libdevcore/Keccak256.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <numeric>
 
 using namespace std;
 using namespace dev;
@@ -47,16 +49,6 @@ namespace
 /******** The Keccak-f[1600] permutation ********/
 
 /*** Constants. ***/
-static uint8_t const rho[24] = \
-	{ 1,  3,   6, 10, 15, 21,
-	28, 36, 45, 55,  2, 14,
-	27, 41, 56,  8, 25, 43,
-	62, 18, 39, 61, 20, 44};
-static uint8_t const pi[24] = \
-	{10,  7, 11, 17, 18, 3,
-	5, 16,  8, 21, 24, 4,
-	15, 23, 19, 13, 12, 2,
-	20, 14, 22,  9, 6,  1};
 static uint64_t const RC[24] = \
 	{1ULL, 0x8082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
 	0x808bULL, 0x80000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
@@ -66,47 +58,98 @@ static uint64_t const RC[24] = \
 	0x8000000080008081ULL, 0x8000000000008080ULL, 0x80000001ULL, 0x8000000080008008ULL};
 
 /*** Helper macros to unroll the permutation. ***/
+// The lanes of the state are kept in 25 local variables, named after their column
+// (a, e, i, o, u) and row (b, g, k, m, s). The rounds alternate between the variables
+// starting with A and those starting with E, so that no temporary copy is needed.
+// Six lanes are stored complemented during the permutation ("lane complementing"), which
+// removes most of the negations from chi.
+// The lane type can be uint64_t or a vector of uint64_t that holds the lanes of several
+// states, so that the same code hashes several inputs at once.
 #define rol(x, s) (((x) << s) | ((x) >> (64 - s)))
-#define REPEAT6(e) e e e e e e
-#define REPEAT24(e) REPEAT6(e e e e)
-#define REPEAT5(e) e e e e e
-#define FOR5(v, s, e) \
-	v = 0;            \
-	REPEAT5(e; v += s;)
+#define ROUND(Lane, A, E, rc)                                                                   \
+	{                                                                                           \
+		Lane const ca = A##ba ^ A##ga ^ A##ka ^ A##ma ^ A##sa;                                  \
+		Lane const ce = A##be ^ A##ge ^ A##ke ^ A##me ^ A##se;                                  \
+		Lane const ci = A##bi ^ A##gi ^ A##ki ^ A##mi ^ A##si;                                  \
+		Lane const co = A##bo ^ A##go ^ A##ko ^ A##mo ^ A##so;                                  \
+		Lane const cu = A##bu ^ A##gu ^ A##ku ^ A##mu ^ A##su;                                  \
+		Lane const da = cu ^ rol(ce, 1);                                                        \
+		Lane const de = ca ^ rol(ci, 1);                                                        \
+		Lane const di = ce ^ rol(co, 1);                                                        \
+		Lane const d_o = ci ^ rol(cu, 1);                                                       \
+		Lane const du = co ^ rol(ca, 1);                                                        \
+		{                                                                                       \
+			Lane const ba = A##ba ^ da, be = rol(A##ge ^ de, 44), bi = rol(A##ki ^ di, 43);     \
+			Lane const bo = rol(A##mo ^ d_o, 21), bu = rol(A##su ^ du, 14);                     \
+			E##ba = ba ^ (be | bi) ^ rc;                                                        \
+			E##be = be ^ (~bi | bo);                                                            \
+			E##bi = bi ^ (bo & bu);                                                             \
+			E##bo = bo ^ (bu | ba);                                                             \
+			E##bu = bu ^ (ba & be);                                                             \
+		}                                                                                       \
+		{                                                                                       \
+			Lane const ga = rol(A##bo ^ d_o, 28), ge = rol(A##gu ^ du, 20), gi = rol(A##ka ^ da, 3); \
+			Lane const go = rol(A##me ^ de, 45), gu = rol(A##si ^ di, 61);                      \
+			E##ga = ga ^ (ge | gi);                                                             \
+			E##ge = ge ^ (gi & go);                                                             \
+			E##gi = gi ^ (go | ~gu);                                                            \
+			E##go = go ^ (gu | ga);                                                             \
+			E##gu = gu ^ (ga & ge);                                                             \
+		}                                                                                       \
+		{                                                                                       \
+			Lane const ka = rol(A##be ^ de, 1), ke = rol(A##gi ^ di, 6), ki = rol(A##ko ^ d_o, 25); \
+			Lane const ko = rol(A##mu ^ du, 8), ku = rol(A##sa ^ da, 18);                       \
+			E##ka = ka ^ (ke | ki);                                                             \
+			E##ke = ke ^ (ki & ko);                                                             \
+			E##ki = ki ^ (~ko & ku);                                                            \
+			E##ko = ~ko ^ (ku | ka);                                                            \
+			E##ku = ku ^ (ka & ke);                                                             \
+		}                                                                                       \
+		{                                                                                       \
+			Lane const ma = rol(A##bu ^ du, 27), me = rol(A##ga ^ da, 36), mi = rol(A##ke ^ de, 10); \
+			Lane const mo = rol(A##mi ^ di, 15), mu = rol(A##so ^ d_o, 56);                     \
+			E##ma = ma ^ (me & mi);                                                             \
+			E##me = me ^ (mi | mo);                                                             \
+			E##mi = mi ^ (~mo | mu);                                                            \
+			E##mo = ~mo ^ (mu & ma);                                                            \
+			E##mu = mu ^ (ma | me);                                                             \
+		}                                                                                       \
+		{                                                                                       \
+			Lane const sa = rol(A##bi ^ di, 62), se = rol(A##go ^ d_o, 55), si = rol(A##ku ^ du, 39); \
+			Lane const so = rol(A##ma ^ da, 41), su = rol(A##se ^ de, 2);                       \
+			E##sa = sa ^ (~se & si);                                                            \
+			E##se = ~se ^ (si | so);                                                            \
+			E##si = si ^ (so & su);                                                             \
+			E##so = so ^ (su | sa);                                                             \
+			E##su = su ^ (sa & se);                                                             \
+		}                                                                                       \
+	}
+#define PERMUTATION(Lane, state)                                                                \
+	{                                                                                           \
+		Lane* s = state;                                                                        \
+		Lane Aba = s[0], Abe = ~s[1], Abi = ~s[2], Abo = s[3], Abu = s[4];                      \
+		Lane Aga = s[5], Age = s[6], Agi = s[7], Ago = ~s[8], Agu = s[9];                       \
+		Lane Aka = s[10], Ake = s[11], Aki = ~s[12], Ako = s[13], Aku = s[14];                  \
+		Lane Ama = s[15], Ame = s[16], Ami = ~s[17], Amo = s[18], Amu = s[19];                  \
+		Lane Asa = ~s[20], Ase = s[21], Asi = s[22], Aso = s[23], Asu = s[24];                  \
+		Lane Eba, Ebe, Ebi, Ebo, Ebu, Ega, Ege, Egi, Ego, Egu, Eka, Eke, Eki, Eko, Eku;         \
+		Lane Ema, Eme, Emi, Emo, Emu, Esa, Ese, Esi, Eso, Esu;                                  \
+		for (int i = 0; i < 24; i += 2)                                                         \
+		{                                                                                       \
+			ROUND(Lane, A, E, RC[i])                                                            \
+			ROUND(Lane, E, A, RC[i + 1])                                                        \
+		}                                                                                       \
+		s[0] = Aba; s[1] = ~Abe; s[2] = ~Abi; s[3] = Abo; s[4] = Abu;                           \
+		s[5] = Aga; s[6] = Age; s[7] = Agi; s[8] = ~Ago; s[9] = Agu;                            \
+		s[10] = Aka; s[11] = Ake; s[12] = ~Aki; s[13] = Ako; s[14] = Aku;                       \
+		s[15] = Ama; s[16] = Ame; s[17] = ~Ami; s[18] = Amo; s[19] = Amu;                       \
+		s[20] = ~Asa; s[21] = Ase; s[22] = Asi; s[23] = Aso; s[24] = Asu;                       \
+	}
 
 /*** Keccak-f[1600] ***/
-static inline void keccakf(void* state) {
-	uint64_t* a = (uint64_t*)state;
-	uint64_t b[5] = {0};
-
-	for (int i = 0; i < 24; i++)
-	{
-		uint8_t x, y;
-		// Theta
-		FOR5(x, 1,
-			b[x] = 0;
-			FOR5(y, 5,
-				b[x] ^= a[x + y]; ))
-		FOR5(x, 1,
-			FOR5(y, 5,
-				a[y + x] ^= b[(x + 4) % 5] ^ rol(b[(x + 1) % 5], 1); ))
-		// Rho and pi
-		uint64_t t = a[1];
-		x = 0;
-		REPEAT24(b[0] = a[pi[x]];
-				a[pi[x]] = rol(t, rho[x]);
-				t = b[0];
-				x++; )
-		// Chi
-		FOR5(y,
-			5,
-			FOR5(x, 1,
-				b[x] = a[y + x];)
-			FOR5(x, 1,
-				a[y + x] = b[x] ^ ((~b[(x + 1) % 5]) & b[(x + 2) % 5]); ))
-		// Iota
-		a[0] ^= RC[i];
-	}
+static inline void keccakf(void* state)
+{
+	PERMUTATION(uint64_t, static_cast<uint64_t*>(state))
 }
 
 /******** The FIPS202-defined functions. ********/
@@ -154,7 +197,7 @@ inline void hash(
 	uint8_t delim
 )
 {
-	uint8_t a[Plen] = {0};
+	alignas(uint64_t) uint8_t a[Plen] = {0};
 	// Absorb input.
 	foldP(in, inlen, xorin);
 	// Xor in the DS and pad frame.
@@ -170,17 +213,128 @@ inline void hash(
 	memset(a, 0, 200);
 }
 
+// Parameters used:
+// The 0x01 is the specific padding for keccak (sha3 uses 0x06) and
+// the way the round size (or window or whatever it was) is calculated.
+// 200 - (256 / 4) is the "rate"
+size_t const keccak256Rate = 200 - (256 / 4);
+uint8_t const keccak256Delim = 0x01;
+
+/// @returns the number of blocks that are absorbed for an input of @a _size bytes.
+size_t keccak256Blocks(size_t _size)
+{
+	return _size / keccak256Rate + 1;
+}
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define KECCAK_AVX2 1
+
+/*** Four Keccak-f[1600] permutations at once. ***/
+// Lane i of all four states in one 256 bit vector. Vector types with vector_size are
+// supported by GCC and Clang, which only use AVX2 instructions for them in functions
+// compiled for AVX2.
+typedef uint64_t Lanes4 __attribute__((vector_size(32)));
+
+__attribute__((target("avx2"))) void keccakf4(Lanes4* _state)
+{
+	PERMUTATION(Lanes4, _state)
+}
+
+/// Computes the Keccak-256 hashes of four inputs, which have to consist of the same number
+/// of blocks, at once.
+__attribute__((target("avx2"))) void keccak256Four(bytesConstRef const* _inputs[4], h256* _outputs[4])
+{
+	size_t const blocks = keccak256Blocks(_inputs[0]->size());
+	size_t const lanesPerBlock = keccak256Rate / 8;
+	Lanes4 state[25] = {};
+	uint8_t lastBlocks[4][keccak256Rate] = {};
+	for (size_t i = 0; i < 4; ++i)
+	{
+		size_t const lastSize = _inputs[i]->size() - (blocks - 1) * keccak256Rate;
+		if (lastSize > 0)
+			memcpy(lastBlocks[i], _inputs[i]->data() + (blocks - 1) * keccak256Rate, lastSize);
+		lastBlocks[i][lastSize] ^= keccak256Delim;
+		lastBlocks[i][keccak256Rate - 1] ^= 0x80;
+	}
+	for (size_t block = 0; block < blocks; ++block)
+	{
+		for (size_t i = 0; i < 4; ++i)
+		{
+			uint8_t const* data = block + 1 < blocks ?
+				_inputs[i]->data() + block * keccak256Rate :
+				lastBlocks[i];
+			for (size_t lane = 0; lane < lanesPerBlock; ++lane)
+			{
+				uint64_t value;
+				memcpy(&value, data + lane * 8, 8);
+				state[lane][i] ^= value;
+			}
+		}
+		keccakf4(state);
+	}
+	for (size_t i = 0; i < 4; ++i)
+		for (size_t lane = 0; lane < h256::size / 8; ++lane)
+		{
+			uint64_t value = state[lane][i];
+			memcpy(_outputs[i]->data() + lane * 8, &value, 8);
+		}
+}
+
+bool supportsAVX2()
+{
+	static bool const supported = []() {
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") != 0;
+	}();
+	return supported;
+}
+#endif
+
 }
 
 h256 keccak256(bytesConstRef _input)
 {
 	h256 output;
-	// Parameters used:
-	// The 0x01 is the specific padding for keccak (sha3 uses 0x06) and
-	// the way the round size (or window or whatever it was) is calculated.
-	// 200 - (256 / 4) is the "rate"
-	hash(output.data(), output.size, _input.data(), _input.size(), 200 - (256 / 4), 0x01);
+	hash(output.data(), output.size, _input.data(), _input.size(), keccak256Rate, keccak256Delim);
 	return output;
 }
 
+vector<h256> keccak256(vector<bytesConstRef> const& _inputs)
+{
+	vector<h256> hashes(_inputs.size());
+	size_t next = 0;
+	vector<size_t> order(_inputs.size());
+	iota(order.begin(), order.end(), 0);
+#if KECCAK_AVX2
+	if (supportsAVX2())
+	{
+		// Hash inputs with the same number of blocks four at a time.
+		stable_sort(order.begin(), order.end(), [&](size_t _a, size_t _b) {
+			return keccak256Blocks(_inputs[_a].size()) < keccak256Blocks(_inputs[_b].size());
+		});
+		while (next + 4 <= order.size())
+			if (keccak256Blocks(_inputs[order[next]].size()) == keccak256Blocks(_inputs[order[next + 3]].size()))
+			{
+				bytesConstRef const* inputs[4];
+				h256* outputs[4];
+				for (size_t i = 0; i < 4; ++i)
+				{
+					inputs[i] = &_inputs[order[next + i]];
+					outputs[i] = &hashes[order[next + i]];
+				}
+				keccak256Four(inputs, outputs);
+				next += 4;
+			}
+			else
+			{
+				hashes[order[next]] = keccak256(_inputs[order[next]]);
+				++next;
+			}
+	}
+#endif
+	for (; next < order.size(); ++next)
+		hashes[order[next]] = keccak256(_inputs[order[next]]);
+	return hashes;
+}
+
 }
@@ -0,0 +1,194 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Collection of timing and memory information about the phases of the compiler.
+ */
+
+#include <libdevcore/Profiler.h>
+
+#include <algorithm>
+
+#if (defined(__linux__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#include <sys/resource.h>
+#define SOL_HAVE_GETRUSAGE
+#endif
+
+using namespace std;
+using namespace dev;
+
+namespace
+{
+thread_local string t_currentContext;
+}
+
+atomic<Profiler*> Profiler::s_active{nullptr};
+
+Profiler::Profiler():
+	m_creationTime(chrono::steady_clock::now())
+{
+}
+
+Profiler::~Profiler()
+{
+	deactivate();
+}
+
+bool Profiler::activate()
+{
+	Profiler* expected = nullptr;
+	return s_active.compare_exchange_strong(expected, this) || expected == this;
+}
+
+void Profiler::deactivate()
+{
+	Profiler* expected = this;
+	s_active.compare_exchange_strong(expected, nullptr);
+}
+
+void Profiler::record(Event _event)
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto thread = m_threads.insert(make_pair(this_thread::get_id(), unsigned(m_threads.size()))).first;
+	_event.thread = thread->second;
+	m_events.emplace_back(move(_event));
+}
+
+vector<Profiler::Event> Profiler::events() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_events;
+}
+
+Json::Value Profiler::summary() const
+{
+	struct Total
+	{
+		unsigned calls = 0;
+		uint64_t time = 0;
+		uint64_t memory = 0;
+	};
+	map<pair<string, string>, Total> totals;
+	for (Event const& event: events())
+	{
+		Total& total = totals[make_pair(event.context, event.phase)];
+		total.calls++;
+		total.time += event.duration;
+		total.memory = max(total.memory, event.memory);
+	}
+
+	Json::Value ret(Json::arrayValue);
+	for (auto const& total: totals)
+	{
+		Json::Value entry(Json::objectValue);
+		entry["context"] = total.first.first;
+		entry["phase"] = total.first.second;
+		entry["calls"] = total.second.calls;
+		entry["time"] = Json::UInt64(total.second.time);
+		entry["memory"] = Json::UInt64(total.second.memory);
+		ret.append(move(entry));
+	}
+	return ret;
+}
+
+Json::Value Profiler::chromeTrace() const
+{
+	Json::Value traceEvents(Json::arrayValue);
+	for (Event const& event: events())
+	{
+		Json::Value traceEvent(Json::objectValue);
+		traceEvent["name"] = event.phase;
+		traceEvent["cat"] = "solc";
+		traceEvent["ph"] = "X";
+		traceEvent["ts"] = Json::UInt64(event.start);
+		traceEvent["dur"] = Json::UInt64(event.duration);
+		traceEvent["pid"] = 1;
+		traceEvent["tid"] = event.thread;
+		traceEvent["args"]["context"] = event.context;
+		traceEvent["args"]["memory"] = Json::UInt64(event.memory);
+		traceEvents.append(move(traceEvent));
+	}
+	Json::Value ret(Json::objectValue);
+	ret["traceEvents"] = move(traceEvents);
+	ret["displayTimeUnit"] = "ms";
+	return ret;
+}
+
+uint64_t Profiler::now() const
+{
+	return uint64_t(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - m_creationTime).count());
+}
+
+uint64_t Profiler::peakMemory()
+{
+#ifdef SOL_HAVE_GETRUSAGE
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#ifdef __APPLE__
+	return uint64_t(usage.ru_maxrss);
+#else
+	// Linux reports kilobytes.
+	return uint64_t(usage.ru_maxrss) * 1024;
+#endif
+#else
+	return 0;
+#endif
+}
+
+ProfilerContext::ProfilerContext(string _context)
+{
+	// Avoid the string copies if nothing is recorded.
+	if (!Profiler::active())
+		return;
+	m_active = true;
+	m_previousContext = move(t_currentContext);
+	t_currentContext = move(_context);
+}
+
+ProfilerContext::~ProfilerContext()
+{
+	if (m_active)
+		t_currentContext = move(m_previousContext);
+}
+
+string const& ProfilerContext::current()
+{
+	return t_currentContext;
+}
+
+ProfilerPhase::ProfilerPhase(char const* _name):
+	m_profiler(Profiler::active()),
+	m_name(_name)
+{
+	if (!m_profiler)
+		return;
+	m_peakMemory = Profiler::peakMemory();
+	m_start = m_profiler->now();
+}
+
+ProfilerPhase::~ProfilerPhase()
+{
+	if (!m_profiler || Profiler::active() != m_profiler)
+		return;
+	Profiler::Event event;
+	event.phase = m_name;
+	event.context = ProfilerContext::current();
+	event.start = m_start;
+	event.duration = m_profiler->now() - m_start;
+	event.memory = Profiler::peakMemory() - m_peakMemory;
+	m_profiler->record(move(event));
+}
@@ -0,0 +1,133 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Collection of timing and memory information about the phases of the compiler.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dev
+{
+
+/**
+ * Records the wall time and the memory usage of the phases of the compiler.
+ *
+ * Phases are marked by ProfilerPhase objects and belong to the context set by the innermost
+ * ProfilerContext of the same thread, e.g. the contract that is compiled. Phases can be nested,
+ * the recorded time includes the time of nested phases.
+ * Events are only recorded while a profiler is active. Otherwise, marking a phase only costs
+ * an atomic load.
+ */
+class Profiler: boost::noncopyable
+{
+public:
+	struct Event
+	{
+		std::string phase;
+		std::string context;
+		/// Index of the thread, in the order in which threads recorded their first event.
+		unsigned thread = 0;
+		/// Start in microseconds since the creation of the profiler.
+		std::uint64_t start = 0;
+		/// Duration in microseconds.
+		std::uint64_t duration = 0;
+		/// Increase of the peak resident set size of the process in bytes. Since this is
+		/// measured for the whole process, it includes allocations of concurrent phases.
+		std::uint64_t memory = 0;
+	};
+
+	Profiler();
+	/// Deactivates the profiler if it is active.
+	~Profiler();
+
+	/// Makes this profiler receive the events of all threads. It must not be deactivated
+	/// or destroyed while phases are running.
+	/// @returns false if another profiler is active.
+	bool activate();
+	void deactivate();
+	/// @returns the active profiler or nullptr.
+	static Profiler* active() { return s_active.load(std::memory_order_acquire); }
+
+	void record(Event _event);
+	std::vector<Event> events() const;
+
+	/// @returns the number of calls, total time and maximal memory increase per context and phase.
+	Json::Value summary() const;
+	/// @returns all events in the trace event format of chrome://tracing.
+	Json::Value chromeTrace() const;
+
+	/// @returns the microseconds since the creation of the profiler.
+	std::uint64_t now() const;
+	/// @returns the peak resident set size of the process in bytes or zero if it is not available.
+	static std::uint64_t peakMemory();
+
+private:
+	static std::atomic<Profiler*> s_active;
+
+	std::chrono::steady_clock::time_point const m_creationTime;
+	mutable std::mutex m_mutex;
+	std::vector<Event> m_events;
+	std::map<std::thread::id, unsigned> m_threads;
+};
+
+/**
+ * Sets the context of all phases started by the current thread during its lifetime.
+ */
+class ProfilerContext: boost::noncopyable
+{
+public:
+	explicit ProfilerContext(std::string _context);
+	~ProfilerContext();
+
+	static std::string const& current();
+
+private:
+	bool m_active = false;
+	std::string m_previousContext;
+};
+
+/**
+ * Records the time and memory used during its lifetime with the active profiler, if any.
+ */
+class ProfilerPhase: boost::noncopyable
+{
+public:
+	/// @param _name name of the phase, must outlive this object.
+	explicit ProfilerPhase(char const* _name);
+	~ProfilerPhase();
+
+private:
+	Profiler* m_profiler;
+	char const* m_name;
+	std::uint64_t m_start = 0;
+	std::uint64_t m_peakMemory = 0;
+};
+
+}
@@ -20,6 +20,10 @@
 #include <libdevcore/SwarmHash.h>
 
 #include <libdevcore/Keccak256.h>
+#include <libdevcore/ThreadPool.h>
+
+#include <algorithm>
+#include <cstring>
 
 using namespace std;
 using namespace dev;
@@ -27,43 +31,110 @@ using namespace dev;
 namespace
 {
 
-bytes toLittleEndian(size_t _size)
+size_t const chunkSize = 0x1000;
+/// Number of hashes that fit into a chunk.
+size_t const branches = chunkSize / 32;
+/// Number of leaves that are hashed at once.
+size_t const leavesPerBatch = 4;
+
+/// Chunk prefixed by the little endian encoding of the size of the data it represents.
+struct Chunk
 {
-	bytes encoded(8);
-	for (size_t i = 0; i < 8; ++i)
-		encoded[i] = (_size >> (8 * i)) & 0xff;
-	return encoded;
-}
+	uint8_t data[8 + chunkSize];
+
+	void setSize(size_t _size)
+	{
+		for (size_t i = 0; i < 8; ++i)
+			data[i] = (uint64_t(_size) >> (8 * i)) & 0xff;
+	}
+	bytesConstRef ref(size_t _payload) const { return bytesConstRef(data, 8 + _payload); }
+};
 
-h256 swarmHashSimple(bytesConstRef _data, size_t _size)
+/// @returns the size of the subtrees below a node that represents @a _length bytes.
+size_t subtreeSize(size_t _length)
 {
-	return keccak256(toLittleEndian(_size) + _data.toBytes());
+	size_t size = chunkSize;
+	while (size * branches < _length)
+		size *= branches;
+	return size;
 }
 
-h256 swarmHashIntermediate(string const& _input, size_t _offset, size_t _length)
+h256 hashNode(bytesConstRef _data);
+
+/// Computes the hashes of the subtrees @a _first to @a _first + @a _count - 1 of size
+/// @a _subtreeSize of @a _data and stores them in @a _hashes.
+void hashSubtrees(bytesConstRef _data, size_t _subtreeSize, size_t _first, size_t _count, h256* _hashes)
 {
-	bytesConstRef ref;
-	bytes innerNodes;
-	if (_length <= 0x1000)
-		ref = bytesConstRef(_input).cropped(_offset, _length);
-	else
+	if (_subtreeSize > chunkSize)
+	{
+		for (size_t i = _first; i < _first + _count; ++i)
+			_hashes[i] = hashNode(_data.cropped(i * _subtreeSize, min(_subtreeSize, _data.size() - i * _subtreeSize)));
+		return;
+	}
+
+	// The subtrees are leaves: Hash several of them at once.
+	Chunk leaves[leavesPerBatch];
+	vector<bytesConstRef> refs;
+	for (size_t batch = _first; batch < _first + _count; batch += leavesPerBatch)
 	{
-		size_t maxRepresentedSize = 0x1000;
-		while (maxRepresentedSize * (0x1000 / 32) < _length)
-			maxRepresentedSize *= (0x1000 / 32);
-		for (size_t i = 0; i < _length; i += maxRepresentedSize)
+		refs.clear();
+		for (size_t i = batch; i < min(batch + leavesPerBatch, _first + _count); ++i)
 		{
-			size_t size = std::min(maxRepresentedSize, _length - i);
-			innerNodes += swarmHashIntermediate(_input, _offset + i, size).asBytes();
+			bytesConstRef leaf = _data.cropped(i * chunkSize, min(chunkSize, _data.size() - i * chunkSize));
+			Chunk& chunk = leaves[i - batch];
+			chunk.setSize(leaf.size());
+			if (!leaf.empty())
+				memcpy(chunk.data + 8, leaf.data(), leaf.size());
+			refs.push_back(chunk.ref(leaf.size()));
 		}
-		ref = bytesConstRef(&innerNodes);
+		vector<h256> hashes = keccak256(refs);
+		copy(hashes.begin(), hashes.end(), _hashes + batch);
 	}
-	return swarmHashSimple(ref, _length);
 }
 
+/// @returns the hash of the node that represents @a _data, given the hashes of its subtrees.
+h256 hashNode(bytesConstRef _data, h256 const* _subtreeHashes, size_t _subtrees)
+{
+	Chunk node;
+	node.setSize(_data.size());
+	for (size_t i = 0; i < _subtrees; ++i)
+		memcpy(node.data + 8 + 32 * i, _subtreeHashes[i].data(), 32);
+	return keccak256(node.ref(32 * _subtrees));
 }
 
-h256 dev::swarmHash(string const& _input)
+h256 hashNode(bytesConstRef _data)
 {
-	return swarmHashIntermediate(_input, 0, _input.size());
+	h256 subtreeHashes[branches];
+	if (_data.size() <= chunkSize)
+	{
+		hashSubtrees(_data, chunkSize, 0, 1, subtreeHashes);
+		return subtreeHashes[0];
+	}
+	size_t const subtree = subtreeSize(_data.size());
+	size_t const subtrees = (_data.size() + subtree - 1) / subtree;
+	hashSubtrees(_data, subtree, 0, subtrees, subtreeHashes);
+	return hashNode(_data, subtreeHashes, subtrees);
+}
+
+}
+
+h256 dev::swarmHash(string const& _input, unsigned _jobs)
+{
+	bytesConstRef data(_input);
+	if (_jobs <= 1 || data.size() <= chunkSize * leavesPerBatch)
+		return hashNode(data);
+
+	// Split the subtrees of the root between the jobs.
+	size_t const subtree = subtreeSize(data.size());
+	size_t const subtrees = (data.size() + subtree - 1) / subtree;
+	size_t perTask = (subtrees + _jobs - 1) / _jobs;
+	perTask = (perTask + leavesPerBatch - 1) / leavesPerBatch * leavesPerBatch;
+	h256 subtreeHashes[branches];
+	ThreadPool pool(_jobs);
+	for (size_t first = 0; first < subtrees; first += perTask)
+		pool.schedule([&, first]() {
+			hashSubtrees(data, subtree, first, min(perTask, subtrees - first), subtreeHashes);
+		});
+	pool.wait();
+	return hashNode(data, subtreeHashes, subtrees);
 }
@@ -26,7 +26,7 @@
 namespace dev
 {
 
-/// Compute the "swarm hash" of @a _input
-h256 swarmHash(std::string const& _input);
+/// Compute the "swarm hash" of @a _input, using up to @a _jobs threads for large inputs.
+h256 swarmHash(std::string const& _input, unsigned _jobs = 1);
 
 }
@@ -0,0 +1,116 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Simple worker pool used to run independent compilation tasks concurrently.
+ */
+
+#include <libdevcore/ThreadPool.h>
+
+using namespace std;
+using namespace dev;
+
+ThreadPool::ThreadPool(unsigned _jobs)
+{
+	// The thread calling wait() acts as one of the workers.
+	for (unsigned i = 1; i < _jobs; ++i)
+		m_workers.emplace_back([this]() { work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_shutdown = true;
+		m_tasks.clear();
+	}
+	m_taskAvailable.notify_all();
+	for (auto& worker: m_workers)
+		worker.join();
+}
+
+void ThreadPool::schedule(function<void()> _task)
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (m_exception)
+			return;
+		m_tasks.emplace_back(move(_task));
+	}
+	m_taskAvailable.notify_one();
+	// wait() might be blocked waiting for running tasks.
+	m_taskFinished.notify_all();
+}
+
+void ThreadPool::wait()
+{
+	unique_lock<mutex> lock(m_mutex);
+	while (true)
+	{
+		if (!m_tasks.empty())
+			runFront(lock);
+		else if (m_running > 0)
+			m_taskFinished.wait(lock);
+		else
+			break;
+	}
+	if (m_exception)
+	{
+		exception_ptr exception;
+		swap(exception, m_exception);
+		rethrow_exception(exception);
+	}
+}
+
+unsigned ThreadPool::hardwareConcurrency()
+{
+	return max(thread::hardware_concurrency(), 1u);
+}
+
+void ThreadPool::work()
+{
+	unique_lock<mutex> lock(m_mutex);
+	while (true)
+	{
+		m_taskAvailable.wait(lock, [this]() { return m_shutdown || !m_tasks.empty(); });
+		if (m_shutdown)
+			return;
+		runFront(lock);
+	}
+}
+
+void ThreadPool::runFront(unique_lock<mutex>& _lock)
+{
+	function<void()> task = move(m_tasks.front());
+	m_tasks.pop_front();
+	++m_running;
+	_lock.unlock();
+	try
+	{
+		task();
+	}
+	catch (...)
+	{
+		_lock.lock();
+		if (!m_exception)
+			m_exception = current_exception();
+		m_tasks.clear();
+		_lock.unlock();
+	}
+	_lock.lock();
+	--m_running;
+	m_taskFinished.notify_all();
+}
@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Simple worker pool used to run independent compilation tasks concurrently.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dev
+{
+
+/**
+ * Pool of worker threads that executes scheduled tasks in FIFO order.
+ *
+ * The thread calling wait() takes part in the execution of tasks, so a pool
+ * created for a single job does not spawn any threads and runs all tasks
+ * sequentially in the order they were scheduled.
+ * Tasks may schedule further tasks. If a task throws, all tasks that did not
+ * start yet are dropped and the exception is rethrown by wait().
+ */
+class ThreadPool: boost::noncopyable
+{
+public:
+	/// Creates a pool that runs at most @a _jobs tasks at the same time.
+	/// A value of zero is treated like one.
+	explicit ThreadPool(unsigned _jobs);
+	~ThreadPool();
+
+	/// Adds a task to the queue. Can be called from within tasks.
+	void schedule(std::function<void()> _task);
+
+	/// Runs tasks until the queue is empty and no task is running anymore.
+	/// Rethrows the first exception thrown by a task, if any.
+	void wait();
+
+	/// @returns the number of jobs to use if the user requested "as many as possible".
+	static unsigned hardwareConcurrency();
+
+private:
+	/// Main loop of the worker threads.
+	void work();
+	/// Pops the front of the queue and runs it with @a _lock released.
+	/// Requires the queue to be non-empty.
+	void runFront(std::unique_lock<std::mutex>& _lock);
+
+	std::mutex m_mutex;
+	/// Signalled when tasks are added or the pool shuts down.
+	std::condition_variable m_taskAvailable;
+	/// Signalled when a task has finished.
+	std::condition_variable m_taskFinished;
+	std::deque<std::function<void()>> m_tasks;
+	size_t m_running = 0;
+	bool m_shutdown = false;
+	std::exception_ptr m_exception;
+	std::vector<std::thread> m_workers;
+};
+
+}
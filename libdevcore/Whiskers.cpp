@@ -25,13 +25,38 @@
 
 #include <libdevcore/Assertions.h>
 
-#include <boost/regex.hpp>
+#include <mutex>
+#include <unordered_map>
 
 using namespace std;
 using namespace dev;
 
+struct Whiskers::Template
+{
+	struct Segment
+	{
+		enum class Kind { Text, Tag, List };
+		Kind kind;
+		/// The literal text or the name of the tag or list.
+		string text;
+		/// The template between the opening and the closing tag of a list.
+		shared_ptr<Template const> listBody;
+	};
+
+	/// The template string, used for error messages.
+	string source;
+	vector<Segment> segments;
+};
+
+namespace
+{
+/// Templates are constructed from string literals in almost all cases. The limit only
+/// prevents unbounded growth if they are generated.
+size_t const maxCachedTemplates = 4096;
+}
+
 Whiskers::Whiskers(string const& _template):
-m_template(_template)
+m_template(parse(_template))
 {
 }
 
@@ -74,60 +99,129 @@ Whiskers& Whiskers::operator ()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_listParameters);
+	string output;
+	output.reserve(m_template->source.size());
+	render(*m_template, m_parameters, nullptr, m_listParameters, output);
+	return output;
 }
 
-string Whiskers::replace(
-	string const& _template,
+shared_ptr<Whiskers::Template const> Whiskers::parse(string const& _template)
+{
+	static mutex cacheMutex;
+	static unordered_map<string, shared_ptr<Template const>> cache;
+	{
+		lock_guard<mutex> lock(cacheMutex);
+		auto it = cache.find(_template);
+		if (it != cache.end())
+			return it->second;
+	}
+
+	// Same matches as a left-to-right search for the regular expression
+	// <([^#/>]+)>|<#([^>]+)>(.*?)</\2>
+	auto parsed = make_shared<Template>();
+	parsed->source = _template;
+	auto addText = [&](size_t _begin, size_t _end)
+	{
+		if (_begin < _end)
+			parsed->segments.push_back({Template::Segment::Kind::Text, _template.substr(_begin, _end - _begin), nullptr});
+	};
+	size_t textStart = 0;
+	size_t pos = 0;
+	while ((pos = _template.find('<', pos)) != string::npos)
+	{
+		size_t tagEnd = _template.find_first_of("#/>", pos + 1);
+		if (tagEnd != string::npos && tagEnd > pos + 1 && _template[tagEnd] == '>')
+		{
+			addText(textStart, pos);
+			parsed->segments.push_back({Template::Segment::Kind::Tag, _template.substr(pos + 1, tagEnd - pos - 1), nullptr});
+			pos = textStart = tagEnd + 1;
+			continue;
+		}
+		if (pos + 1 < _template.size() && _template[pos + 1] == '#')
+		{
+			size_t nameEnd = _template.find('>', pos + 2);
+			if (nameEnd != string::npos && nameEnd > pos + 2)
+			{
+				string name = _template.substr(pos + 2, nameEnd - pos - 2);
+				size_t closingTag = _template.find("</" + name + ">", nameEnd + 1);
+				if (closingTag != string::npos)
+				{
+					addText(textStart, pos);
+					parsed->segments.push_back({
+						Template::Segment::Kind::List,
+						name,
+						parse(_template.substr(nameEnd + 1, closingTag - nameEnd - 1))
+					});
+					pos = textStart = closingTag + name.size() + 3;
+					continue;
+				}
+			}
+		}
+		++pos;
+	}
+	addText(textStart, _template.size());
+
+	lock_guard<mutex> lock(cacheMutex);
+	if (cache.size() < maxCachedTemplates)
+		cache.emplace(_template, parsed);
+	return parsed;
+}
+
+void Whiskers::render(
+	Template const& _template,
 	StringMap const& _parameters,
-	map<string, vector<StringMap>> const& _listParameters
+	StringMap const* _listItem,
+	StringListMap const& _listParameters,
+	string& _output
 )
 {
-	using namespace boost;
-	static regex listOrTag("<([^#/>]+)>|<#([^>]+)>(.*?)</\\2>");
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		if (!tagName.empty())
+	for (Template::Segment const& segment: _template.segments)
+		switch (segment.kind)
+		{
+		case Template::Segment::Kind::Text:
+			_output += segment.text;
+			break;
+		case Template::Segment::Kind::Tag:
 		{
+			if (_listItem)
+			{
+				auto it = _listItem->find(segment.text);
+				if (it != _listItem->end())
+				{
+					_output += it->second;
+					break;
+				}
+			}
+			auto it = _parameters.find(segment.text);
 			assertThrow(
-				_parameters.count(tagName),
+				it != _parameters.end(),
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + segment.text + " not provided.\n" +
 				"Template:\n" +
-				_template
+				_template.source
 			);
-			return _parameters.at(tagName);
+			_output += it->second;
+			break;
 		}
-		else
+		case Template::Segment::Kind::List:
 		{
-			string listName(_match[2]);
-			string templ(_match[3]);
-			assertThrow(!listName.empty(), WhiskersError, "");
+			assertThrow(!segment.text.empty(), WhiskersError, "");
+			auto it = _listParameters.find(segment.text);
 			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
+				it != _listParameters.end(),
+				WhiskersError, "List parameter " + segment.text + " not set."
 			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters));
-			return replacement;
+			for (auto const& parameters: it->second)
+			{
+				for (auto const& parameter: parameters)
+					assertThrow(
+						!_parameters.count(parameter.first),
+						WhiskersError,
+						"Parameter collision"
+					);
+				render(*segment.listBody, _parameters, &parameters, StringListMap(), _output);
+			}
+			break;
+		}
 		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
 }
-
@@ -25,8 +25,9 @@
 
 #include <libdevcore/Exceptions.h>
 
-#include <string>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace dev
@@ -51,6 +52,9 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
 /// results in s == "HEAD\nkey1 -> value1\nkey2 -> value2\n"
 ///
 /// Note that lists cannot themselves contain lists - this would be a future feature.
+///
+/// Templates are parsed once and the parsed form is cached, so constructing many instances from
+/// the same template string is cheap.
 class Whiskers
 {
 public:
@@ -70,16 +74,22 @@ public:
 	std::string render() const;
 
 private:
-	static std::string replace(
-		std::string const& _template,
+	/// Template parsed into literal text, tags and lists.
+	struct Template;
+
+	/// @returns the parsed form of @a _template, shared between all instances with the same template.
+	static std::shared_ptr<Template const> parse(std::string const& _template);
+	/// Appends @a _template with the given parameters to @a _output. The parameters of @a _listItem,
+	/// if given, take part in the replacement and must not collide with @a _parameters.
+	static void render(
+		Template const& _template,
 		StringMap const& _parameters,
-		StringListMap const& _listParameters = StringListMap()
+		StringMap const* _listItem,
+		StringListMap const& _listParameters,
+		std::string& _output
 	);
 
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
-
-	std::string m_template;
+	std::shared_ptr<Template const> m_template;
 	StringMap m_parameters;
 	StringListMap m_listParameters;
 };
@@ -28,6 +28,13 @@
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <libdevcore/Profiler.h>
+#include <libdevcore/ThreadPool.h>
+
+#include <boost/algorithm/cxx11/any_of.hpp>
+#include <boost/optional.hpp>
 
 #include <fstream>
 #include <json/json.h>
@@ -94,6 +101,43 @@ void Assembly::injectStart(AssemblyItem const& _i)
 	m_items.insert(m_items.begin(), _i);
 }
 
+vector<vector<size_t>> Assembly::independentSubGroups() const
+{
+	// The same assembly can be reachable from different subs, e.g. a contract created
+	// by both the creation and the runtime code of another contract.
+	vector<vector<size_t>> groups;
+	vector<set<Assembly const*>> groupAssemblies;
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	{
+		vector<size_t> group{subId};
+		set<Assembly const*> assemblies;
+		m_subs[subId]->collectAssemblies(assemblies);
+		// Merge all earlier groups that share an assembly with this sub.
+		for (size_t i = 0; i < groups.size();)
+			if (boost::algorithm::any_of(assemblies, [&](Assembly const* _a) { return groupAssemblies[i].count(_a); }))
+			{
+				group.insert(group.end(), groups[i].begin(), groups[i].end());
+				assemblies.insert(groupAssemblies[i].begin(), groupAssemblies[i].end());
+				groups.erase(groups.begin() + i);
+				groupAssemblies.erase(groupAssemblies.begin() + i);
+			}
+			else
+				++i;
+		sort(group.begin(), group.end());
+		groups.emplace_back(move(group));
+		groupAssemblies.emplace_back(move(assemblies));
+	}
+	return groups;
+}
+
+void Assembly::collectAssemblies(set<Assembly const*>& o_assemblies) const
+{
+	if (!o_assemblies.insert(this).second)
+		return;
+	for (auto const& sub: m_subs)
+		sub->collectAssemblies(o_assemblies);
+}
+
 unsigned Assembly::bytesRequired(unsigned subTagSize) const
 {
 	for (unsigned tagSize = subTagSize; true; ++tagSize)
@@ -112,16 +156,14 @@ unsigned Assembly::bytesRequired(unsigned subTagSize) const
 namespace
 {
 
-string locationFromSources(StringMap const& _sourceCodes, SourceLocation const& _location)
+string locationFromSources(set<string> const& _sourceNames, SourceLocation const& _location)
 {
-	if (_location.isEmpty() || !_location.source.get() || _sourceCodes.empty() || _location.start >= _location.end || _location.start < 0)
+	if (_location.isEmpty() || !_location.source.get() || _location.start >= _location.end || _location.start < 0)
 		return "";
-
-	auto it = _sourceCodes.find(_location.source->name());
-	if (it == _sourceCodes.end())
+	if (!_sourceNames.count(_location.source->name()))
 		return "";
 
-	string const& source = it->second;
+	string const& source = _location.source->source();
 	if (size_t(_location.start) >= source.size())
 		return "";
 
@@ -136,8 +178,8 @@ string locationFromSources(StringMap const& _sourceCodes, SourceLocation const&
 class Functionalizer
 {
 public:
-	Functionalizer (ostream& _out, string const& _prefix, StringMap const& _sourceCodes):
-		m_out(_out), m_prefix(_prefix), m_sourceCodes(_sourceCodes)
+	Functionalizer (ostream& _out, string const& _prefix, set<string> const& _sourceNames):
+		m_out(_out), m_prefix(_prefix), m_sourceNames(_sourceNames)
 	{}
 
 	void feed(AssemblyItem const& _item)
@@ -193,7 +235,7 @@ public:
 			m_out << " \"" + m_location.source->name() + "\"";
 		if (!m_location.isEmpty())
 			m_out << ":" << to_string(m_location.start) + ":" + to_string(m_location.end);
-		m_out << "  " << locationFromSources(m_sourceCodes, m_location);
+		m_out << "  " << locationFromSources(m_sourceNames, m_location);
 		m_out << " */" << endl;
 	}
 
@@ -203,14 +245,14 @@ private:
 
 	ostream& m_out;
 	string const& m_prefix;
-	StringMap const& m_sourceCodes;
+	set<string> const& m_sourceNames;
 };
 
 }
 
-void Assembly::assemblyStream(ostream& _out, string const& _prefix, StringMap const& _sourceCodes) const
+void Assembly::assemblyStream(ostream& _out, string const& _prefix, set<string> const& _sourceNames) const
 {
-	Functionalizer f(_out, _prefix, _sourceCodes);
+	Functionalizer f(_out, _prefix, _sourceNames);
 
 	for (auto const& i: m_items)
 		f.feed(i);
@@ -226,7 +268,7 @@ void Assembly::assemblyStream(ostream& _out, string const& _prefix, StringMap co
 		for (size_t i = 0; i < m_subs.size(); ++i)
 		{
 			_out << endl << _prefix << "sub_" << i << ": assembly {\n";
-			m_subs[i]->assemblyStream(_out, _prefix + "    ", _sourceCodes);
+			m_subs[i]->assemblyStream(_out, _prefix + "    ", _sourceNames);
 			_out << _prefix << "}" << endl;
 		}
 	}
@@ -235,10 +277,10 @@ void Assembly::assemblyStream(ostream& _out, string const& _prefix, StringMap co
 		_out << endl << _prefix << "auxdata: 0x" << toHex(m_auxiliaryData) << endl;
 }
 
-string Assembly::assemblyString(StringMap const& _sourceCodes) const
+string Assembly::assemblyString(set<string> const& _sourceNames) const
 {
 	ostringstream tmp;
-	assemblyStream(tmp, "", _sourceCodes);
+	assemblyStream(tmp, "", _sourceNames);
 	return tmp.str();
 }
 
@@ -262,7 +304,7 @@ string Assembly::toStringInHex(u256 _value)
 	return hexStr.str();
 }
 
-Json::Value Assembly::assemblyJSON(StringMap const& _sourceCodes) const
+Json::Value Assembly::assemblyJSON() const
 {
 	Json::Value root;
 
@@ -338,7 +380,7 @@ Json::Value Assembly::assemblyJSON(StringMap const& _sourceCodes) const
 		{
 			std::stringstream hexStr;
 			hexStr << hex << i;
-			data[hexStr.str()] = m_subs[i]->assemblyJSON(_sourceCodes);
+			data[hexStr.str()] = m_subs[i]->assemblyJSON();
 		}
 	}
 
@@ -388,25 +430,93 @@ Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 	return *this;
 }
 
+namespace
+{
+
+/// Minimal number of items the common subexpression eliminator processes in one task,
+/// smaller pieces of work are not worth the scheduling overhead.
+size_t const c_minItemsPerCSETask = 512;
+
+/// Runs the common subexpression eliminator on the items in [_begin, _end), which end
+/// at the end of a basic block (or at the end of the assembly).
+/// @returns the optimised items if they are shorter than the original ones.
+boost::optional<AssemblyItems> optimiseChunk(
+	AssemblyItems::const_iterator _begin,
+	AssemblyItems::const_iterator _end,
+	bool _usesMSize
+)
+{
+	KnownState emptyState;
+	CommonSubexpressionEliminator eliminator{emptyState};
+	auto iter = eliminator.feedItems(_begin, _end, _usesMSize);
+	assertThrow(iter == _end, OptimizerException, "Invalid chunk for common subexpression elimination.");
+	try
+	{
+		AssemblyItems optimisedChunk = eliminator.getOptimizedItems();
+		if (optimisedChunk.size() < size_t(_end - _begin))
+			return optimisedChunk;
+	}
+	catch (StackTooDeepException const&)
+	{
+		// This might happen if the opcode reconstruction is not as efficient
+		// as the hand-crafted code.
+	}
+	catch (ItemNotAvailableException const&)
+	{
+		// This might happen if e.g. associativity and commutativity rules
+		// reorganise the expression tree, but not all leaves are available.
+	}
+	return boost::none;
+}
+
+}
+
 map<u256, u256> Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
 	std::set<size_t> _tagsReferencedFromOutside
 )
 {
-	// Run optimisation for sub-assemblies.
+	// Run optimisation for sub-assemblies. Each of them only looks at and modifies the items
+	// of this assembly that refer to its own tags, so they can be optimised in any order,
+	// unless they share assemblies. The tag replacements are applied in the order of the
+	// sub ids afterwards, so the result does not depend on the scheduling.
+	vector<set<size_t>> subTagsReferenced;
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		subTagsReferenced.emplace_back(JumpdestRemover::referencedTags(m_items, subId));
+	vector<map<u256, u256>> subTagReplacements(m_subs.size());
+	auto optimiseSubs = [&](vector<size_t> const& _subIds, unsigned _jobs)
 	{
 		OptimiserSettings settings = _settings;
 		// Disable creation mode for sub-assemblies.
 		settings.isCreation = false;
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
-		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
+		settings.jobs = _jobs;
+		for (size_t subId: _subIds)
+			subTagReplacements[subId] = m_subs[subId]->optimiseInternal(settings, move(subTagsReferenced[subId]));
+	};
+
+	vector<vector<size_t>> subGroups = independentSubGroups();
+	if (_settings.jobs <= 1 || subGroups.size() <= 1)
+		for (auto const& group: subGroups)
+			optimiseSubs(group, _settings.jobs);
+	else
+	{
+		// Distribute the jobs, so that nested sub-assemblies do not multiply the number of threads.
+		unsigned jobsPerGroup = max(1u, _settings.jobs / unsigned(subGroups.size()));
+		string const profilerContext = ProfilerContext::current();
+		ThreadPool pool(min(_settings.jobs, unsigned(subGroups.size())));
+		for (auto const& group: subGroups)
+			pool.schedule([&, jobsPerGroup]()
+			{
+				ProfilerContext context(profilerContext);
+				optimiseSubs(group, jobsPerGroup);
+			});
+		pool.wait();
 	}
 
+	// Apply the replacements (can be empty).
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId], subId);
+
 	map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
 	for (unsigned count = 1; count > 0;)
@@ -415,6 +525,7 @@ map<u256, u256> Assembly::optimiseInternal(
 
 		if (_settings.runJumpdestRemover)
 		{
+			ProfilerPhase phase("evmasm/JumpdestRemover");
 			JumpdestRemover jumpdestOpt{m_items};
 			if (jumpdestOpt.optimise(_tagsReferencedFromOutside))
 				count++;
@@ -422,6 +533,7 @@ map<u256, u256> Assembly::optimiseInternal(
 
 		if (_settings.runPeephole)
 		{
+			ProfilerPhase phase("evmasm/PeepholeOptimiser");
 			PeepholeOptimiser peepOpt{m_items};
 			while (peepOpt.optimise())
 			{
@@ -433,6 +545,7 @@ map<u256, u256> Assembly::optimiseInternal(
 		// This only modifies PushTags, we have to run again to actually remove code.
 		if (_settings.runDeduplicate)
 		{
+			ProfilerPhase phase("evmasm/BlockDeduplicator");
 			BlockDeduplicator dedup{m_items};
 			if (dedup.deduplicate())
 			{
@@ -458,46 +571,63 @@ map<u256, u256> Assembly::optimiseInternal(
 
 		if (_settings.runCSE)
 		{
+			ProfilerPhase phase("evmasm/CommonSubexpressionEliminator");
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
-			AssemblyItems optimisedItems;
-
 			bool usesMSize = (find(m_items.begin(), m_items.end(), AssemblyItem{Instruction::MSIZE}) != m_items.end());
 
-			auto iter = m_items.begin();
-			while (iter != m_items.end())
+			// Split the items into chunks that end after an item breaking the basic block.
+			// Every chunk is optimised starting from an empty state, so they are independent.
+			vector<size_t> chunkStarts{0};
+			for (size_t i = 0; i < m_items.size(); ++i)
+				if (SemanticInformation::breaksCSEAnalysisBlock(m_items[i], usesMSize) && i + 1 < m_items.size())
+					chunkStarts.push_back(i + 1);
+			if (!m_items.empty())
+				chunkStarts.push_back(m_items.size());
+			size_t const chunks = chunkStarts.size() - 1;
+
+			vector<boost::optional<AssemblyItems>> optimisedChunks(chunks);
+			auto optimiseChunks = [&](size_t _first, size_t _last)
 			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
-				auto orig = iter;
-				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
-				bool shouldReplace = false;
-				AssemblyItems optimisedChunk;
-				try
-				{
-					optimisedChunk = eliminator.getOptimizedItems();
-					shouldReplace = (optimisedChunk.size() < size_t(iter - orig));
-				}
-				catch (StackTooDeepException const&)
-				{
-					// This might happen if the opcode reconstruction is not as efficient
-					// as the hand-crafted code.
-				}
-				catch (ItemNotAvailableException const&)
+				for (size_t chunk = _first; chunk < _last; ++chunk)
+					optimisedChunks[chunk] = optimiseChunk(
+						m_items.cbegin() + chunkStarts[chunk],
+						m_items.cbegin() + chunkStarts[chunk + 1],
+						usesMSize
+					);
+			};
+			if (_settings.jobs <= 1 || m_items.size() < 2 * c_minItemsPerCSETask)
+				optimiseChunks(0, chunks);
+			else
+			{
+				size_t itemsPerTask = max(c_minItemsPerCSETask, m_items.size() / (4 * _settings.jobs));
+				ThreadPool pool(_settings.jobs);
+				for (size_t first = 0; first < chunks;)
 				{
-					// This might happen if e.g. associativity and commutativity rules
-					// reorganise the expression tree, but not all leaves are available.
+					size_t last = first + 1;
+					while (last < chunks && chunkStarts[last] - chunkStarts[first] < itemsPerTask)
+						++last;
+					pool.schedule([&, first, last]() { optimiseChunks(first, last); });
+					first = last;
 				}
+				pool.wait();
+			}
 
-				if (shouldReplace)
+			// Splice the chunks back together in their original order.
+			AssemblyItems optimisedItems;
+			for (size_t chunk = 0; chunk < chunks; ++chunk)
+				if (optimisedChunks[chunk])
 				{
 					count++;
-					optimisedItems += optimisedChunk;
+					optimisedItems += move(*optimisedChunks[chunk]);
 				}
 				else
-					copy(orig, iter, back_inserter(optimisedItems));
-			}
+					copy(
+						m_items.begin() + chunkStarts[chunk],
+						m_items.begin() + chunkStarts[chunk + 1],
+						back_inserter(optimisedItems)
+					);
 			if (optimisedItems.size() < m_items.size())
 			{
 				m_items = move(optimisedItems);
@@ -507,12 +637,15 @@ map<u256, u256> Assembly::optimiseInternal(
 	}
 
 	if (_settings.runConstantOptimiser)
+	{
+		ProfilerPhase phase("evmasm/ConstantOptimiser");
 		ConstantOptimisationMethod::optimiseConstants(
 			_settings.isCreation,
 			_settings.isCreation ? 1 : _settings.expectedExecutionsPerDeployment,
 			_settings.evmVersion,
 			*this
 		);
+	}
 
 	return tagReplacements;
 }
@@ -603,7 +736,7 @@ LinkerObject const& Assembly::assemble() const
 		case PushSubSize:
 		{
 			auto s = m_subs.at(size_t(i.data()))->assemble().bytecode.size();
-			i.setPushedValue(u256(s));
+			i.setPushedValue(s);
 			uint8_t b = max<unsigned>(1, dev::bytesRequired(s));
 			ret.bytecode.push_back((uint8_t)Instruction::PUSH1 - 1 + b);
 			ret.bytecode.resize(ret.bytecode.size() + b);
@@ -34,6 +34,7 @@
 #include <iostream>
 #include <sstream>
 #include <memory>
+#include <set>
 
 namespace dev
 {
@@ -111,6 +112,8 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = 200;
+		/// Maximal number of sub-assemblies optimised concurrently. Does not influence the result.
+		unsigned jobs = 1;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
@@ -125,19 +128,17 @@ public:
 	Assembly& optimise(bool _enable, langutil::EVMVersion _evmVersion, bool _isCreation, size_t _runs);
 
 	/// Create a text representation of the assembly.
-	std::string assemblyString(
-		StringMap const& _sourceCodes = StringMap()
-	) const;
+	/// If an item refers to one of the sources in @a _sourceNames, the start of its source
+	/// code is printed next to its location. It is taken from the character stream of the location.
+	std::string assemblyString(std::set<std::string> const& _sourceNames = {}) const;
 	void assemblyStream(
 		std::ostream& _out,
 		std::string const& _prefix = "",
-		StringMap const& _sourceCodes = StringMap()
+		std::set<std::string> const& _sourceNames = {}
 	) const;
 
 	/// Create a JSON representation of the assembly.
-	Json::Value assemblyJSON(
-		StringMap const& _sourceCodes = StringMap()
-	) const;
+	Json::Value assemblyJSON() const;
 
 public:
 	// These features are only used by LLL
@@ -160,6 +161,12 @@ protected:
 	unsigned bytesRequired(unsigned subTagSize) const;
 
 private:
+	/// @returns the ids of the sub-assemblies grouped such that no assembly is reachable from
+	/// two different groups. The ids in each group are ascending.
+	std::vector<std::vector<size_t>> independentSubGroups() const;
+	/// Adds this assembly and all its (transitive) sub-assemblies to @a o_assemblies.
+	void collectAssemblies(std::set<Assembly const*>& o_assemblies) const;
+
 	static Json::Value createJsonValue(std::string _name, int _begin, int _end, std::string _value = std::string(), std::string _jumpType = std::string());
 	static std::string toStringInHex(u256 _value);
 
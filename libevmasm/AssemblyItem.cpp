@@ -20,7 +20,12 @@
 #include <libdevcore/CommonData.h>
 #include <libdevcore/FixedHash.h>
 
+#include <boost/functional/hash.hpp>
+
+#include <array>
 #include <fstream>
+#include <mutex>
+#include <unordered_map>
 
 using namespace std;
 using namespace dev;
@@ -28,11 +33,106 @@ using namespace dev::eth;
 
 static_assert(sizeof(size_t) <= 8, "size_t must be at most 64-bits wide");
 
+namespace
+{
+
+/// Process-wide pool of values that do not fit into 64 bits. It is split into shards
+/// with separate locks, so that concurrent compilations rarely wait for each other.
+/// The pool only refers to the values weakly, a value is removed once the last item
+/// using it is destroyed.
+class LargeValuePool
+{
+public:
+	shared_ptr<u256 const> intern(u256 const& _value)
+	{
+		Shard& shard = shardFor(_value);
+		lock_guard<mutex> lock(shard.valuesMutex);
+		weak_ptr<u256 const>& entry = shard.values[_value];
+		if (shared_ptr<u256 const> value = entry.lock())
+			return value;
+		shared_ptr<u256 const> value(new u256(_value), [this](u256 const* _v) { release(_v); });
+		entry = value;
+		return value;
+	}
+
+	size_t size()
+	{
+		size_t result = 0;
+		for (Shard& shard: m_shards)
+		{
+			lock_guard<mutex> lock(shard.valuesMutex);
+			result += shard.values.size();
+		}
+		return result;
+	}
+
+private:
+	struct Hash
+	{
+		size_t operator()(u256 const& _value) const
+		{
+			auto const& backend = _value.backend();
+			return boost::hash_range(backend.limbs(), backend.limbs() + backend.size());
+		}
+	};
+	struct Shard
+	{
+		mutex valuesMutex;
+		unordered_map<u256, weak_ptr<u256 const>, Hash> values;
+	};
+
+	Shard& shardFor(u256 const& _value) { return m_shards[Hash{}(_value) % m_shards.size()]; }
+
+	void release(u256 const* _value)
+	{
+		{
+			Shard& shard = shardFor(*_value);
+			lock_guard<mutex> lock(shard.valuesMutex);
+			auto it = shard.values.find(*_value);
+			// The same value might have been interned again in the meantime.
+			if (it != shard.values.end() && it->second.expired())
+				shard.values.erase(it);
+		}
+		delete _value;
+	}
+
+	array<Shard, 16> m_shards;
+};
+
+/// The pool is never destroyed, since items with large values might be destroyed
+/// after it during the shutdown of the process.
+LargeValuePool& largeValuePool()
+{
+	static LargeValuePool* pool = new LargeValuePool();
+	return *pool;
+}
+
+}
+
+void AssemblyItem::storeData(u256 const& _data)
+{
+	if (_data <= numeric_limits<uint64_t>::max())
+	{
+		m_smallData = uint64_t(_data);
+		m_largeData.reset();
+	}
+	else
+	{
+		m_smallData = 0;
+		m_largeData = largeValuePool().intern(_data);
+	}
+}
+
+size_t AssemblyItem::largeValuesInUse()
+{
+	return largeValuePool().size();
+}
+
 AssemblyItem AssemblyItem::toSubAssemblyTag(size_t _subId) const
 {
 	assertThrow(data() < (u256(1) << 64), Exception, "Tag already has subassembly set.");
 	assertThrow(m_type == PushTag || m_type == Tag, Exception, "");
-	size_t tag = size_t(u256(data()) & 0xffffffffffffffffULL);
+	size_t tag = size_t(data() & 0xffffffffffffffffULL);
 	AssemblyItem r = *this;
 	r.m_type = PushTag;
 	r.setPushTagSubIdAndTag(_subId, tag);
@@ -42,7 +142,7 @@ AssemblyItem AssemblyItem::toSubAssemblyTag(size_t _subId) const
 pair<size_t, size_t> AssemblyItem::splitForeignPushTag() const
 {
 	assertThrow(m_type == PushTag || m_type == Tag, Exception, "");
-	u256 combined = u256(data());
+	u256 combined = data();
 	size_t subId = size_t((combined >> 64) - 1);
 	size_t tag = size_t(combined & 0xffffffffffffffffULL);
 	return make_pair(subId, tag);
@@ -26,7 +26,10 @@
 #include <liblangutil/SourceLocation.h>
 #include <libdevcore/Common.h>
 #include <libdevcore/Assertions.h>
+#include <boost/optional.hpp>
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <sstream>
 
 namespace dev
@@ -34,7 +37,7 @@ namespace dev
 namespace eth
 {
 
-enum AssemblyItemType {
+enum AssemblyItemType: uint8_t {
 	UndefinedItem,
 	Operation,
 	Push,
@@ -51,10 +54,19 @@ enum AssemblyItemType {
 
 class Assembly;
 
+/**
+ * Item of an assembly, i.e. an instruction, a push of some kind or a tag.
+ *
+ * Items are copied a lot by the optimiser, so copying them should be cheap:
+ * Data that fits into 64 bits (almost all pushes and tags) is stored inline and larger
+ * values are shared by all items with the same value through a process-wide pool, which
+ * drops a value once it is not used anymore. This also allows comparing the data of two
+ * items without looking at the values.
+ */
 class AssemblyItem
 {
 public:
-	enum class JumpType { Ordinary, IntoFunction, OutOfFunction };
+	enum class JumpType: uint8_t { Ordinary, IntoFunction, OutOfFunction };
 
 	AssemblyItem(u256 _push, langutil::SourceLocation _location = langutil::SourceLocation()):
 		AssemblyItem(Push, std::move(_push), std::move(_location)) { }
@@ -70,7 +82,7 @@ public:
 		if (m_type == Operation)
 			m_instruction = Instruction(uint8_t(_data));
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			storeData(_data);
 	}
 	AssemblyItem(AssemblyItem const&) = default;
 	AssemblyItem(AssemblyItem&&) = default;
@@ -89,8 +101,8 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { assertThrow(m_type != Operation, Exception, ""); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, Exception, ""); m_data = std::make_shared<u256>(_data); }
+	u256 data() const { assertThrow(m_type != Operation, Exception, ""); return m_largeData ? *m_largeData : u256(m_smallData); }
+	void setData(u256 const& _data) { assertThrow(m_type != Operation, Exception, ""); storeData(_data); }
 
 	/// @returns the instruction of this item (only valid if type() == Operation)
 	Instruction instruction() const { assertThrow(m_type == Operation, Exception, ""); return m_instruction; }
@@ -103,7 +115,8 @@ public:
 		if (type() == Operation)
 			return instruction() == _other.instruction();
 		else
-			return data() == _other.data();
+			// Values are stored inline if and only if they fit, and large values are interned.
+			return m_smallData == _other.m_smallData && m_largeData == _other.m_largeData;
 	}
 	bool operator!=(AssemblyItem const& _other) const { return !operator==(_other); }
 	/// Less-than operator compatible with operator==.
@@ -113,6 +126,8 @@ public:
 			return type() < _other.type();
 		else if (type() == Operation)
 			return instruction() < _other.instruction();
+		else if (!m_largeData && !_other.m_largeData)
+			return m_smallData < _other.m_smallData;
 		else
 			return data() < _other.data();
 	}
@@ -141,20 +156,32 @@ public:
 	JumpType getJumpType() const { return m_jumpType; }
 	std::string getJumpTypeAsString() const;
 
-	void setPushedValue(u256 const& _value) const { m_pushedValue = std::make_shared<u256>(_value); }
-	u256 const* pushedValue() const { return m_pushedValue.get(); }
+	void setPushedValue(size_t _value) const { m_pushedValue = _value; }
+	boost::optional<size_t> const& pushedValue() const { return m_pushedValue; }
 
 	std::string toAssemblyText() const;
 
+	/// @returns the number of distinct values that do not fit into 64 bits and are used
+	/// by existing items.
+	static size_t largeValuesInUse();
+
 private:
+	/// Stores @a _data inline if it fits into 64 bits and in the pool of large values otherwise.
+	void storeData(u256 const& _data);
+
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
-	langutil::SourceLocation m_location;
 	JumpType m_jumpType = JumpType::Ordinary;
+	/// Data if m_type != Operation and it fits into 64 bits.
+	uint64_t m_smallData = 0;
+	/// Data if m_type != Operation and it does not fit into 64 bits, shared with the pool.
+	std::shared_ptr<u256 const> m_largeData;
+	/// Copied with the item. It shares the character stream of its source, so copying an item
+	/// with a location still updates a reference count.
+	langutil::SourceLocation m_location;
 	/// Pushed value for operations with data to be determined during assembly stage,
 	/// e.g. PushSubSize, PushTag, PushSub, etc.
-	mutable std::shared_ptr<u256> m_pushedValue;
+	mutable boost::optional<size_t> m_pushedValue;
 };
 
 using AssemblyItems = std::vector<AssemblyItem>;
@@ -96,7 +96,7 @@ KnownState::StoreOperation KnownState::feedItem(AssemblyItem const& _item, bool
 		assertThrow(_item.deposit() == 1, InvalidDeposit, "");
 		if (_item.pushedValue())
 			// only available after assembly stage, should not be used for optimisation
-			setStackElement(++m_stackHeight, m_expressionClasses->find(*_item.pushedValue()));
+			setStackElement(++m_stackHeight, m_expressionClasses->find(u256(*_item.pushedValue())));
 		else
 			setStackElement(++m_stackHeight, m_expressionClasses->find(_item, {}, _copyItem));
 	}
@@ -361,7 +361,7 @@ KnownState::Id KnownState::applyKeccak256(
 {
 	AssemblyItem keccak256Item(Instruction::KECCAK256, _location);
 	// Special logic if length is a short constant, otherwise we cannot tell.
-	u256 const* l = m_expressionClasses->knownConstant(_length);
+	boost::optional<u256> l = m_expressionClasses->knownConstant(_length);
 	// unknown or too large length
 	if (!l || *l > 128)
 		return m_expressionClasses->find(keccak256Item, {_start, _length}, true, m_sequenceNumber);
@@ -53,9 +53,80 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <algorithm>
+#include <array>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 using namespace std;
 using namespace langutil;
 
+namespace
+{
+
+/// Set of characters the bulk scanning helpers look for.
+struct CharSet
+{
+	CharSet(initializer_list<char> _chars, bool _lineBreaks): lineBreaks(_lineBreaks)
+	{
+		solAssert(0 < _chars.size() && _chars.size() <= chars.size(), "");
+		// Unused entries repeat the first character, so that all of them can be compared.
+		chars.fill(*_chars.begin());
+		copy(_chars.begin(), _chars.end(), chars.begin());
+	}
+	bool contains(char _c) const
+	{
+		return
+			(lineBreaks && 0x0a <= _c && _c <= 0x0d) ||
+			_c == chars[0] || _c == chars[1] || _c == chars[2] || _c == chars[3];
+	}
+
+	array<char, 4> chars;
+	bool lineBreaks;
+};
+
+/// @returns the number of characters in [_begin, _end) before the first one whose
+/// membership in @a _set is @a _member.
+size_t findFirst(char const* _begin, char const* _end, CharSet const& _set, bool _member)
+{
+	char const* it = _begin;
+#if defined(__SSE2__)
+	__m128i const c0 = _mm_set1_epi8(_set.chars[0]);
+	__m128i const c1 = _mm_set1_epi8(_set.chars[1]);
+	__m128i const c2 = _mm_set1_epi8(_set.chars[2]);
+	__m128i const c3 = _mm_set1_epi8(_set.chars[3]);
+	__m128i const lineBreakStart = _mm_set1_epi8(0x0a);
+	__m128i const lineBreakRange = _mm_set1_epi8(0x0d - 0x0a);
+	for (; _end - it >= 16; it += 16)
+	{
+		__m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(it));
+		__m128i matches = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(block, c0), _mm_cmpeq_epi8(block, c1)),
+			_mm_or_si128(_mm_cmpeq_epi8(block, c2), _mm_cmpeq_epi8(block, c3))
+		);
+		if (_set.lineBreaks)
+		{
+			// Unsigned comparison of the offset from 0x0a: offset <= range iff min(offset, range) == offset.
+			__m128i offset = _mm_sub_epi8(block, lineBreakStart);
+			matches = _mm_or_si128(matches, _mm_cmpeq_epi8(_mm_min_epu8(offset, lineBreakRange), offset));
+		}
+		unsigned mask = unsigned(_mm_movemask_epi8(matches));
+		if (!_member)
+			mask = ~mask & 0xffff;
+		if (mask)
+			return size_t(it - _begin) + size_t(__builtin_ctz(mask));
+	}
+#endif
+	for (; it != _end; ++it)
+		if (_set.contains(*it) == _member)
+			break;
+	return size_t(it - _begin);
+}
+
+}
+
 char CharStream::advanceAndGet(size_t _chars)
 {
 	if (isPastEndOfInput())
@@ -63,7 +134,7 @@ char CharStream::advanceAndGet(size_t _chars)
 	m_position += _chars;
 	if (isPastEndOfInput())
 		return 0;
-	return m_source[m_position];
+	return (*m_source)[m_position];
 }
 
 char CharStream::rollback(size_t _amount)
@@ -73,35 +144,53 @@ char CharStream::rollback(size_t _amount)
 	return get();
 }
 
+size_t CharStream::charsUntil(initializer_list<char> _stopChars, bool _stopAtLineBreaks) const
+{
+	if (isPastEndOfInput())
+		return 0;
+	char const* data = m_source->data();
+	return findFirst(data + m_position, data + m_source->size(), CharSet(_stopChars, _stopAtLineBreaks), true);
+}
+
+size_t CharStream::charsWhile(initializer_list<char> _chars) const
+{
+	if (isPastEndOfInput())
+		return 0;
+	char const* data = m_source->data();
+	return findFirst(data + m_position, data + m_source->size(), CharSet(_chars, false), false);
+}
+
 string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
 	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), _position);
+	string const& source = *m_source;
+	size_type searchStart = min<size_type>(source.size(), _position);
 	if (searchStart > 0)
 		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
+	size_type lineStart = source.rfind('\n', searchStart);
 	if (lineStart == string::npos)
 		lineStart = 0;
 	else
 		lineStart++;
-	return m_source.substr(
+	return source.substr(
 		lineStart,
-		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
+		min(source.find('\n', lineStart), source.size()) - lineStart
 	);
 }
 
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
 	using size_type = string::size_type;
-	size_type searchPosition = min<size_type>(m_source.size(), _position);
-	int lineNumber = count(m_source.begin(), m_source.begin() + searchPosition, '\n');
+	string const& source = *m_source;
+	size_type searchPosition = min<size_type>(source.size(), _position);
+	int lineNumber = count(source.begin(), source.begin() + searchPosition, '\n');
 	size_type lineStart;
 	if (searchPosition == 0)
 		lineStart = 0;
 	else
 	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
+		lineStart = source.rfind('\n', searchPosition - 1);
 		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
 	}
 	return tuple<int, int>(lineNumber, searchPosition - lineStart);
@@ -53,6 +53,8 @@
 #pragma once
 
 #include <cstdint>
+#include <initializer_list>
+#include <memory>
 #include <string>
 #include <tuple>
 
@@ -63,24 +65,42 @@ namespace langutil
  * Bidirectional stream of characters.
  *
  * This CharStream is used by lexical analyzers as the source.
+ * The source text is immutable and shared between copies of the stream, so that
+ * large sources are not duplicated when they are passed around.
  */
 class CharStream
 {
 public:
-	CharStream() = default;
-	explicit CharStream(std::string const& _source, std::string const& name):
-		m_source(_source), m_name(name) {}
+	CharStream(): m_source(std::make_shared<std::string const>()) {}
+	explicit CharStream(std::string _source, std::string _name):
+		m_source(std::make_shared<std::string const>(std::move(_source))), m_name(std::move(_name)) {}
+	/// Creates a stream that shares the (non-null) source text with other users.
+	explicit CharStream(std::shared_ptr<std::string const> _source, std::string _name):
+		m_source(std::move(_source)), m_name(std::move(_name)) {}
 
 	int position() const { return m_position; }
-	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
+	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source->size(); }
 
-	char get(size_t _charsForward = 0) const { return m_source[m_position + _charsForward]; }
+	char get(size_t _charsForward = 0) const { return (*m_source)[m_position + _charsForward]; }
 	char advanceAndGet(size_t _chars = 1);
 	char rollback(size_t _amount);
 
+	///@{
+	///@name Bulk scanning helpers
+	/// They inspect the characters from the current position on without advancing and
+	/// process 16 characters at a time where SSE2 is available.
+	/// @returns the number of characters before the first one that is in @a _stopChars
+	/// (at most four) or, if @a _stopAtLineBreaks is set, in the range 0x0a to 0x0d.
+	size_t charsUntil(std::initializer_list<char> _stopChars, bool _stopAtLineBreaks = false) const;
+	/// @returns the number of characters before the first one that is not in @a _chars
+	/// (at most four).
+	size_t charsWhile(std::initializer_list<char> _chars) const;
+	///@}
+
 	void reset() { m_position = 0; }
 
-	std::string const& source() const noexcept { return m_source; }
+	std::string const& source() const noexcept { return *m_source; }
+	std::shared_ptr<std::string const> const& sharedSource() const noexcept { return m_source; }
 	std::string const& name() const noexcept { return m_name; }
 
 	///@{
@@ -92,7 +112,7 @@ public:
 	///@}
 
 private:
-	std::string m_source;
+	std::shared_ptr<std::string const> m_source;
 	std::string m_name;
 	size_t m_position{0};
 };
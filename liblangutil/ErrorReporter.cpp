@@ -135,9 +135,18 @@ ErrorList const& ErrorReporter::errors() const
 	return m_errorList;
 }
 
+void ErrorReporter::replay(ErrorList const& _errorList)
+{
+	for (auto const& error: _errorList)
+		if (!checkForExcessiveErrors(error->type()))
+			m_errorList.push_back(error);
+}
+
 void ErrorReporter::clear()
 {
 	m_errorList.clear();
+	m_errorCount = 0;
+	m_warningCount = 0;
 }
 
 void ErrorReporter::declarationError(SourceLocation const& _location, SecondarySourceLocation const& _secondaryLocation, string const& _description)
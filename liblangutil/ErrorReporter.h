@@ -50,6 +50,10 @@ public:
 		m_errorList += _errorList;
 	}
 
+	/// Reports the errors of @a _errorList again, for example when a result of an earlier
+	/// run is reused. Unlike append(), the limits on the number of errors apply.
+	void replay(ErrorList const& _errorList);
+
 	void warning(std::string const& _description);
 
 	void warning(SourceLocation const& _location, std::string const& _description);
@@ -112,6 +116,12 @@ public:
 
 	void clear();
 
+	/// @returns true if warnings were dropped because there were too many.
+	bool warningsDropped() const
+	{
+		return m_warningCount >= c_maxWarningsAllowed;
+	}
+
 	/// @returns true iff there is any error (ignores warnings).
 	bool hasErrors() const
 	{
@@ -228,8 +228,13 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 bool Scanner::skipWhitespace()
 {
 	int const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
+	if (isWhiteSpace(m_char))
+	{
+		// The current character is not necessarily the one in the source, see
+		// skipMultiLineComment(), so always advance past it first.
 		advance();
+		m_char = m_source->advanceAndGet(m_source->charsWhile({' ', '\n', '\t', '\r'}));
+	}
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -245,7 +250,13 @@ Token Scanner::skipSingleLineComment()
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
 	while (!isUnicodeLinebreak())
-		if (!advance()) break;
+	{
+		// Jump to the next character that can start a line terminator.
+		if (size_t skipped = m_source->charsUntil({char(0xc2), char(0xe2)}, true))
+			m_char = m_source->advanceAndGet(skipped);
+		else if (!advance())
+			break;
+	}
 
 	return Token::Whitespace;
 }
@@ -279,8 +290,9 @@ Token Scanner::scanSingleLineDocComment()
 			// Any line terminator that is not '\n' is considered to end the
 			// comment.
 			break;
-		addCommentLiteralChar(m_char);
-		advance();
+		// The current character is always added, the following ones up to
+		// the next possible line terminator are copied at once.
+		addCommentLiteralChars(max<size_t>(1, m_source->charsUntil({char(0xc2), char(0xe2)}, true)));
 	}
 	literal.complete();
 	return Token::CommentLiteral;
@@ -291,13 +303,18 @@ Token Scanner::skipMultiLineComment()
 	advance();
 	while (!isSourcePastEndOfInput())
 	{
-		char ch = m_char;
+		// Only a '*' can start the terminator, skip everything before it.
+		if (m_char != '*')
+		{
+			m_char = m_source->advanceAndGet(m_source->charsUntil({'*'}));
+			continue;
+		}
 		advance();
 
 		// If we have reached the end of the multi-line comment, we
 		// consume the '/' and insert a whitespace. This way all
 		// multi-line comments are treated as whitespace.
-		if (ch == '*' && m_char == '/')
+		if (m_char == '/')
 		{
 			m_char = ' ';
 			return Token::Whitespace;
@@ -349,9 +366,10 @@ Token Scanner::scanMultiLineDocComment()
 			endFound = true;
 			break;
 		}
-		addCommentLiteralChar(m_char);
+		// The current character is always added, the following ones up to
+		// the next '*' or newline are copied at once.
+		addCommentLiteralChars(max<size_t>(1, m_source->charsUntil({'*', '\n'})));
 		charsAdded = true;
-		advance();
 	}
 	literal.complete();
 	if (!endFound)
@@ -707,6 +725,12 @@ Token Scanner::scanString()
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
 	while (m_char != quote && !isSourcePastEndOfInput() && !isUnicodeLinebreak())
 	{
+		// Copy the run of characters that need no further inspection at once.
+		if (size_t plain = m_source->charsUntil({quote, '\\', char(0xc2), char(0xe2)}, true))
+		{
+			addLiteralChars(plain);
+			continue;
+		}
 		char c = m_char;
 		advance();
 		if (c == '\\')
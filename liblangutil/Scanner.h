@@ -186,6 +186,17 @@ private:
 	inline void addLiteralChar(char c) { m_nextToken.literal.push_back(c); }
 	inline void addCommentLiteralChar(char c) { m_nextSkippedComment.literal.push_back(c); }
 	inline void addLiteralCharAndAdvance() { addLiteralChar(m_char); advance(); }
+	/// Append the next @a _count characters of the source at once and advance past them.
+	void addLiteralChars(size_t _count)
+	{
+		m_nextToken.literal.append(m_source->source(), m_source->position(), _count);
+		m_char = m_source->advanceAndGet(_count);
+	}
+	void addCommentLiteralChars(size_t _count)
+	{
+		m_nextSkippedComment.literal.append(m_source->source(), m_source->position(), _count);
+		m_char = m_source->advanceAndGet(_count);
+	}
 	void addUnicodeAsUTF8(unsigned codepoint);
 	///@}
 
@@ -25,6 +25,7 @@
 
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/Types.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <memory>
 
 using namespace std;
@@ -35,7 +36,7 @@ namespace solidity
 {
 
 GlobalContext::GlobalContext():
-m_magicVariables(vector<shared_ptr<MagicVariableDeclaration const>>{
+m_magicVariables(vector<shared_ptr<MagicVariableDeclaration>>{
 	make_shared<MagicVariableDeclaration>("abi", make_shared<MagicType>(MagicType::Kind::ABI)),
 	make_shared<MagicVariableDeclaration>("addmod", make_shared<FunctionType>(strings{"uint256", "uint256", "uint256"}, strings{"uint256"}, FunctionType::Kind::AddMod, false, StateMutability::Pure)),
 	make_shared<MagicVariableDeclaration>("assert", make_shared<FunctionType>(strings{"bool"}, strings{}, FunctionType::Kind::Assert, false, StateMutability::Pure)),
@@ -51,7 +52,7 @@ m_magicVariables(vector<shared_ptr<MagicVariableDeclaration const>>{
 	make_shared<MagicVariableDeclaration>("log4", make_shared<FunctionType>(strings{"bytes32", "bytes32", "bytes32", "bytes32", "bytes32"}, strings{}, FunctionType::Kind::Log4)),
 	make_shared<MagicVariableDeclaration>("msg", make_shared<MagicType>(MagicType::Kind::Message)),
 	make_shared<MagicVariableDeclaration>("mulmod", make_shared<FunctionType>(strings{"uint256", "uint256", "uint256"}, strings{"uint256"}, FunctionType::Kind::MulMod, false, StateMutability::Pure)),
-	make_shared<MagicVariableDeclaration>("now", make_shared<IntegerType>(256)),
+	make_shared<MagicVariableDeclaration>("now", TypeProvider::uint256()),
 	make_shared<MagicVariableDeclaration>("require", make_shared<FunctionType>(strings{"bool"}, strings{}, FunctionType::Kind::Require, false, StateMutability::Pure)),
 	make_shared<MagicVariableDeclaration>("require", make_shared<FunctionType>(strings{"bool", "string memory"}, strings{}, FunctionType::Kind::Require, false, StateMutability::Pure)),
 	make_shared<MagicVariableDeclaration>("revert", make_shared<FunctionType>(strings(), strings(), FunctionType::Kind::Revert, false, StateMutability::Pure)),
@@ -82,7 +83,7 @@ vector<Declaration const*> GlobalContext::declarations() const
 {
 	vector<Declaration const*> declarations;
 	declarations.reserve(m_magicVariables.size());
-	for (ASTPointer<Declaration const> const& variable: m_magicVariables)
+	for (auto const& variable: m_magicVariables)
 		declarations.push_back(variable.get());
 	return declarations;
 }
@@ -91,7 +92,7 @@ MagicVariableDeclaration const* GlobalContext::currentThis() const
 {
 	if (!m_thisPointer[m_currentContract])
 		m_thisPointer[m_currentContract] = make_shared<MagicVariableDeclaration>("this", make_shared<ContractType>(*m_currentContract));
-	return m_thisPointer[m_currentContract].get();
+	return renewedID(*m_thisPointer[m_currentContract]);
 
 }
 
@@ -99,7 +100,24 @@ MagicVariableDeclaration const* GlobalContext::currentSuper() const
 {
 	if (!m_superPointer[m_currentContract])
 		m_superPointer[m_currentContract] = make_shared<MagicVariableDeclaration>("super", make_shared<ContractType>(*m_currentContract, true));
-	return m_superPointer[m_currentContract].get();
+	return renewedID(*m_superPointer[m_currentContract]);
+}
+
+void GlobalContext::renewIDs()
+{
+	for (auto const& variable: m_magicVariables)
+		variable->renewID();
+	for (auto const& thisPointer: m_thisPointer)
+		m_outdatedIDs.insert(thisPointer.second.get());
+	for (auto const& superPointer: m_superPointer)
+		m_outdatedIDs.insert(superPointer.second.get());
+}
+
+MagicVariableDeclaration const* GlobalContext::renewedID(MagicVariableDeclaration& _declaration) const
+{
+	if (m_outdatedIDs.erase(&_declaration))
+		_declaration.renewID();
+	return &_declaration;
 }
 
 }
@@ -26,6 +26,7 @@
 #include <boost/noncopyable.hpp>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -49,15 +50,23 @@ public:
 	void setCurrentContract(ContractDefinition const& _contract);
 	MagicVariableDeclaration const* currentThis() const;
 	MagicVariableDeclaration const* currentSuper() const;
+	/// Gives the global declarations the IDs they would get in a new global context. The
+	/// declarations of "this" and "super" get their new IDs once they are requested again.
+	void renewIDs();
 
 	/// @returns a vector of all implicit global declarations excluding "this".
 	std::vector<Declaration const*> declarations() const;
 
 private:
-	std::vector<std::shared_ptr<MagicVariableDeclaration const>> m_magicVariables;
+	/// @returns the declaration @a _declaration after renewing its ID if it is outdated.
+	MagicVariableDeclaration const* renewedID(MagicVariableDeclaration& _declaration) const;
+
+	std::vector<std::shared_ptr<MagicVariableDeclaration>> m_magicVariables;
 	ContractDefinition const* m_currentContract = nullptr;
-	std::map<ContractDefinition const*, std::shared_ptr<MagicVariableDeclaration const>> mutable m_thisPointer;
-	std::map<ContractDefinition const*, std::shared_ptr<MagicVariableDeclaration const>> mutable m_superPointer;
+	std::map<ContractDefinition const*, std::shared_ptr<MagicVariableDeclaration>> mutable m_thisPointer;
+	std::map<ContractDefinition const*, std::shared_ptr<MagicVariableDeclaration>> mutable m_superPointer;
+	/// Declarations of "this" and "super" whose IDs were not renewed yet.
+	std::set<MagicVariableDeclaration const*> mutable m_outdatedIDs;
 };
 
 }
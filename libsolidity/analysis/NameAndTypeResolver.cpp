@@ -44,8 +44,9 @@ NameAndTypeResolver::NameAndTypeResolver(
 	m_scopes(_scopes),
 	m_errorReporter(_errorReporter)
 {
-	if (!m_scopes[nullptr])
-		m_scopes[nullptr].reset(new DeclarationContainer());
+	if (m_scopes[nullptr])
+		return;
+	m_scopes[nullptr].reset(new DeclarationContainer());
 	for (Declaration const* declaration: _globals)
 	{
 		solAssert(m_scopes[nullptr]->registerDeclaration(*declaration), "Unable to register global declaration.");
@@ -51,7 +51,8 @@ class NameAndTypeResolver: private boost::noncopyable
 public:
 	/// Creates the resolver with the given declarations added to the global scope.
 	/// @param _scopes mapping of scopes to be used (usually default constructed), these
-	/// are filled during the lifetime of this object.
+	/// are filled during the lifetime of this object. If it already contains a global
+	/// scope, it is used as is and @a _globals is ignored.
 	NameAndTypeResolver(
 		std::vector<Declaration const*> const& _globals,
 		std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& _scopes,
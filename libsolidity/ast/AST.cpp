@@ -38,7 +38,8 @@ class IDDispenser
 {
 public:
 	static size_t next() { return ++instance(); }
-	static void reset() { instance() = 0; }
+	static void reset(size_t _lastID) { instance() = _lastID; }
+	static size_t last() { return instance(); }
 private:
 	static size_t& instance()
 	{
@@ -59,9 +60,19 @@ ASTNode::~ASTNode()
 	delete m_annotation;
 }
 
-void ASTNode::resetID()
+void ASTNode::resetID(size_t _lastID)
 {
-	IDDispenser::reset();
+	IDDispenser::reset(_lastID);
+}
+
+size_t ASTNode::lastID()
+{
+	return IDDispenser::last();
+}
+
+void ASTNode::renewID()
+{
+	m_id = IDDispenser::next();
 }
 
 ASTAnnotation& ASTNode::annotation() const
@@ -154,6 +165,7 @@ FunctionDefinition const* ContractDefinition::fallbackFunction() const
 
 vector<EventDefinition const*> const& ContractDefinition::interfaceEvents() const
 {
+	lock_guard<recursive_mutex> lock(lazyInitialisationMutex());
 	if (!m_interfaceEvents)
 	{
 		set<string> eventsSeen;
@@ -179,10 +191,12 @@ vector<EventDefinition const*> const& ContractDefinition::interfaceEvents() cons
 
 vector<pair<FixedHash<4>, FunctionTypePointer>> const& ContractDefinition::interfaceFunctionList() const
 {
+	lock_guard<recursive_mutex> lock(lazyInitialisationMutex());
 	if (!m_interfaceFunctionList)
 	{
 		set<string> signaturesSeen;
-		m_interfaceFunctionList.reset(new vector<pair<FixedHash<4>, FunctionTypePointer>>());
+		vector<string> signatures;
+		vector<FunctionTypePointer> interfaceFunctions;
 		for (ContractDefinition const* contract: annotation().linearizedBaseContracts)
 		{
 			vector<FunctionTypePointer> functions;
@@ -201,17 +215,27 @@ vector<pair<FixedHash<4>, FunctionTypePointer>> const& ContractDefinition::inter
 				if (signaturesSeen.count(functionSignature) == 0)
 				{
 					signaturesSeen.insert(functionSignature);
-					FixedHash<4> hash(dev::keccak256(functionSignature));
-					m_interfaceFunctionList->emplace_back(hash, fun);
+					signatures.push_back(move(functionSignature));
+					interfaceFunctions.push_back(fun);
 				}
 			}
 		}
+
+		// Hash all signatures at once, which is faster than one by one.
+		vector<bytesConstRef> signatureRefs;
+		for (string const& signature: signatures)
+			signatureRefs.emplace_back(signature);
+		vector<h256> hashes = dev::keccak256(signatureRefs);
+		m_interfaceFunctionList.reset(new vector<pair<FixedHash<4>, FunctionTypePointer>>());
+		for (size_t i = 0; i < hashes.size(); ++i)
+			m_interfaceFunctionList->emplace_back(FixedHash<4>(hashes[i]), interfaceFunctions[i]);
 	}
 	return *m_interfaceFunctionList;
 }
 
 vector<Declaration const*> const& ContractDefinition::inheritableMembers() const
 {
+	lock_guard<recursive_mutex> lock(lazyInitialisationMutex());
 	if (!m_inheritableMembers)
 	{
 		set<string> memberSeen;
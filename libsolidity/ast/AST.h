@@ -69,8 +69,16 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	size_t id() const { return m_id; }
-	/// Resets the global ID counter. This invalidates all previous IDs.
-	static void resetID();
+	/// Resets the global ID counter, so that the next node gets the ID @a _lastID + 1.
+	/// This invalidates all previous IDs.
+	static void resetID(size_t _lastID = 0);
+	/// @returns the ID of the most recently created node.
+	static size_t lastID();
+	/// Changes the ID of this node. Used to give the nodes of a reused AST the IDs they would
+	/// get in a new compilation.
+	void setID(size_t _id) { m_id = _id; }
+	/// Gives this node the next ID of the global counter, as if it was created now.
+	void renewID();
 
 	virtual void accept(ASTVisitor& _visitor) = 0;
 	virtual void accept(ASTConstVisitor& _visitor) const = 0;
@@ -105,7 +113,7 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	size_t m_id = 0;
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
 	mutable ASTAnnotation* m_annotation = nullptr;
 
@@ -24,9 +24,13 @@
 #include <libsolidity/ast/AST.h>
 #include <libyul/AsmData.h>
 #include <libyul/AsmPrinter.h>
+#include <libdevcore/Common.h>
+#include <libdevcore/JSON.h>
 #include <libdevcore/UTF8.h>
 #include <boost/algorithm/string/join.hpp>
 
+#include <algorithm>
+
 using namespace std;
 using namespace langutil;
 
@@ -35,6 +39,16 @@ namespace dev
 namespace solidity
 {
 
+namespace
+{
+
+/// Member of the placeholders for nodes that are converted later in toCompactJson(),
+/// holds the index of the node in m_deferredNodes.
+/// It cannot clash with the other members, which are keywords or identifiers.
+char const* const c_deferredNode = "\x01node";
+
+}
+
 ASTJsonConverter::ASTJsonConverter(bool _legacy, map<string, unsigned> _sourceIndices):
 	m_legacy(_legacy),
 	m_sourceIndices(_sourceIndices)
@@ -118,6 +132,13 @@ void ASTJsonConverter::setJsonNode(
 		if (!attrs.empty())
 			m_currentValue["attributes"] = std::move(attrs);
 	}
+
+	if (m_output)
+	{
+		// This converts the children, which overwrites m_currentValue.
+		Json::Value node = std::move(m_currentValue);
+		writeCompact(node);
+	}
 }
 
 string ASTJsonConverter::sourceLocationToString(SourceLocation const& _location) const
@@ -191,10 +212,97 @@ void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node)
 
 Json::Value&& ASTJsonConverter::toJson(ASTNode const& _node)
 {
-	_node.accept(*this);
+	if (m_output)
+	{
+		// The "name" member makes the placeholder look like a node to the legacy format.
+		m_currentValue = Json::objectValue;
+		m_currentValue["name"] = Json::nullValue;
+		m_currentValue[c_deferredNode] = Json::UInt64(m_deferredNodes.size());
+		m_deferredNodes.push_back(&_node);
+	}
+	else
+		_node.accept(*this);
 	return std::move(m_currentValue);
 }
 
+string ASTJsonConverter::toCompactJson(ASTNode const& _node)
+{
+	solAssert(!m_output, "");
+	string output;
+	m_output = &output;
+	ScopeGuard resetOutput([&]() { m_output = nullptr; m_deferredNodes.clear(); });
+	_node.accept(*this);
+	return output;
+}
+
+void ASTJsonConverter::writeCompact(Json::Value const& _value)
+{
+	string& output = *m_output;
+	switch (_value.type())
+	{
+	case Json::nullValue:
+		output += "null";
+		break;
+	case Json::intValue:
+		output += Json::valueToString(_value.asLargestInt());
+		break;
+	case Json::uintValue:
+		output += Json::valueToString(_value.asLargestUInt());
+		break;
+	case Json::booleanValue:
+		output += _value.asBool() ? "true" : "false";
+		break;
+	case Json::stringValue:
+		writeCompactString(_value.asString());
+		break;
+	case Json::arrayValue:
+		output += '[';
+		for (Json::ArrayIndex i = 0; i < _value.size(); ++i)
+		{
+			if (i > 0)
+				output += ',';
+			writeCompact(_value[i]);
+		}
+		output += ']';
+		break;
+	case Json::objectValue:
+		if (_value.isMember(c_deferredNode))
+		{
+			m_deferredNodes.at(_value[c_deferredNode].asUInt64())->accept(*this);
+			break;
+		}
+		output += '{';
+		// Members are iterated in the same (sorted) order in which the JSON writer prints them.
+		for (auto it = _value.begin(); it != _value.end(); ++it)
+		{
+			if (it != _value.begin())
+				output += ',';
+			writeCompactString(it.name());
+			output += ':';
+			writeCompact(*it);
+		}
+		output += '}';
+		break;
+	default:
+		output += jsonCompactPrint(_value);
+		break;
+	}
+}
+
+void ASTJsonConverter::writeCompactString(string const& _value)
+{
+	bool plain = all_of(_value.begin(), _value.end(), [](char _c) {
+		return ' ' <= _c && _c <= '~' && _c != '"' && _c != '\\';
+	});
+	if (plain)
+		*m_output += '"' + _value + '"';
+	else if (_value.find('\0') == string::npos)
+		*m_output += Json::valueToQuotedString(_value.c_str());
+	else
+		// Let the JSON writer escape strings that contain null characters.
+		*m_output += jsonCompactPrint(Json::Value(_value));
+}
+
 bool ASTJsonConverter::visit(SourceUnit const& _node)
 {
 	Json::Value exportedSymbols = Json::objectValue;
@@ -259,7 +367,7 @@ bool ASTJsonConverter::visit(ContractDefinition const& _node)
 		make_pair("fullyImplemented", _node.annotation().unimplementedFunctions.empty()),
 		make_pair("linearizedBaseContracts", getContainerIds(_node.annotation().linearizedBaseContracts)),
 		make_pair("baseContracts", toJson(_node.baseContracts())),
-		make_pair("contractDependencies", getContainerIds(_node.annotation().contractDependencies)),
+		make_pair("contractDependencies", getContainerIds(_node.annotation().contractDependencies, true)),
 		make_pair("nodes", toJson(_node.subNodes())),
 		make_pair("scope", idOrNull(_node.scope()))
 	});
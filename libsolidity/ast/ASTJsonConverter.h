@@ -27,6 +27,7 @@
 #include <liblangutil/Exceptions.h>
 
 #include <json/json.h>
+#include <algorithm>
 #include <ostream>
 #include <stack>
 
@@ -56,6 +57,9 @@ public:
 	/// Output the json representation of the AST to _stream.
 	void print(std::ostream& _stream, ASTNode const& _node);
 	Json::Value&& toJson(ASTNode const& _node);
+	/// @returns the same as jsonCompactPrint(toJson(_node)), but writes the nodes directly
+	/// into the output without creating a JSON value for the whole tree first.
+	std::string toCompactJson(ASTNode const& _node);
 	template <class T>
 	Json::Value toJson(std::vector<ASTPointer<T>> const& _nodes)
 	{
@@ -148,15 +152,20 @@ private:
 		return _node.id();
 	}
 	template<class Container>
-	static Json::Value getContainerIds(Container const& container)
+	static Json::Value getContainerIds(Container const& _container, bool _order = false)
 	{
-		Json::Value tmp(Json::arrayValue);
-		for (auto const& element: container)
+		std::vector<int> tmp;
+		for (auto const& element: _container)
 		{
 			solAssert(element, "");
-			tmp.append(nodeId(*element));
+			tmp.push_back(nodeId(*element));
 		}
-		return tmp;
+		if (_order)
+			std::sort(tmp.begin(), tmp.end());
+		Json::Value json(Json::arrayValue);
+		for (int value: tmp)
+			json.append(value);
+		return json;
 	}
 	static Json::Value typePointerToJson(TypePointer _tp, bool _short = false);
 	static Json::Value typePointerToJson(boost::optional<FuncCallArguments> const& _tps);
@@ -169,11 +178,20 @@ private:
 		solAssert(_array.isArray(), "");
 		_array.append(std::move(_value));
 	}
+	/// Appends the compact representation of @a _value to m_output. Deferred nodes
+	/// are converted and written when they are reached.
+	void writeCompact(Json::Value const& _value);
+	void writeCompactString(std::string const& _value);
 
 	bool m_legacy = false; ///< if true, use legacy format
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
 	Json::Value m_currentValue;
 	std::map<std::string, unsigned> m_sourceIndices;
+	/// Output of toCompactJson() while it runs. In that case, toJson() does not convert
+	/// the node but returns a reference to it, so that nodes are converted in output order.
+	std::string* m_output = nullptr;
+	/// Nodes returned as placeholders by toJson() during toCompactJson().
+	std::vector<ASTNode const*> m_deferredNodes;
 };
 
 }
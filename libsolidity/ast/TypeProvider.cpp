@@ -0,0 +1,101 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Shared instances of elementary types.
+ */
+
+#include <libsolidity/ast/TypeProvider.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace
+{
+
+thread_local TypeProvider const* t_activeProvider = nullptr;
+
+}
+
+TypeProvider::TypeProvider():
+	m_boolean(make_shared<BoolType>())
+{
+	for (unsigned bytes = 1; bytes <= 32; ++bytes)
+	{
+		m_integers[bytes - 1][0] = make_shared<IntegerType>(bytes * 8, IntegerType::Modifier::Unsigned);
+		m_integers[bytes - 1][1] = make_shared<IntegerType>(bytes * 8, IntegerType::Modifier::Signed);
+		m_fixedBytes[bytes - 1] = make_shared<FixedBytesType>(bytes);
+	}
+	m_addresses[0] = make_shared<AddressType>(StateMutability::NonPayable);
+	m_addresses[1] = make_shared<AddressType>(StateMutability::Payable);
+}
+
+TypeProvider::Scope::Scope(TypeProvider const& _provider):
+	m_previous(t_activeProvider)
+{
+	t_activeProvider = &_provider;
+}
+
+TypeProvider::Scope::~Scope()
+{
+	t_activeProvider = m_previous;
+}
+
+TypeProvider const* TypeProvider::active()
+{
+	return t_activeProvider;
+}
+
+shared_ptr<BoolType const> TypeProvider::boolean()
+{
+	if (TypeProvider const* provider = active())
+		return provider->m_boolean;
+	return make_shared<BoolType>();
+}
+
+shared_ptr<IntegerType const> TypeProvider::integer(unsigned _bits, IntegerType::Modifier _modifier)
+{
+	solAssert(8 <= _bits && _bits <= 256 && _bits % 8 == 0, "Invalid bit number for integer type: " + dev::toString(_bits));
+	if (TypeProvider const* provider = active())
+		return provider->m_integers[_bits / 8 - 1][_modifier == IntegerType::Modifier::Signed ? 1 : 0];
+	return make_shared<IntegerType>(_bits, _modifier);
+}
+
+shared_ptr<FixedBytesType const> TypeProvider::fixedBytes(unsigned _bytes)
+{
+	solAssert(0 < _bytes && _bytes <= 32, "Invalid byte number for fixed bytes type: " + dev::toString(_bytes));
+	if (TypeProvider const* provider = active())
+		return provider->m_fixedBytes[_bytes - 1];
+	return make_shared<FixedBytesType>(_bytes);
+}
+
+shared_ptr<FixedPointType const> TypeProvider::fixedPoint(
+	unsigned _totalBits,
+	unsigned _fractionalDigits,
+	FixedPointType::Modifier _modifier
+)
+{
+	// There are too many fixed point types to create all of them upfront.
+	return make_shared<FixedPointType>(_totalBits, _fractionalDigits, _modifier);
+}
+
+shared_ptr<AddressType const> TypeProvider::address(StateMutability _stateMutability)
+{
+	if (TypeProvider const* provider = active())
+		return provider->m_addresses[_stateMutability == StateMutability::Payable ? 1 : 0];
+	return make_shared<AddressType>(_stateMutability);
+}
@@ -0,0 +1,95 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Shared instances of elementary types.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/Types.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <array>
+#include <memory>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Hands out a single instance per elementary value type, so that type checking does
+ * not allocate a new object every time it refers to e.g. uint256 or bool.
+ *
+ * Only bool, integer, fixed bytes and address types are shared. All other types are
+ * created anew each time and types are still compared structurally, since e.g. function
+ * types that compare equal can still refer to different declarations.
+ *
+ * Every compiler stack owns a provider and activates it for the threads working on it
+ * via a Scope. Without an active provider, a new instance is created for every request.
+ * Types cache their members per contract definition, so a provider must not be used
+ * for contracts that are created after contracts it was used with were destroyed.
+ * All instances are created upfront, so that the provider can be used by several
+ * threads at the same time without locking.
+ */
+class TypeProvider: boost::noncopyable
+{
+public:
+	TypeProvider();
+
+	/// Activates a provider for the current thread until it is destroyed.
+	class Scope: boost::noncopyable
+	{
+	public:
+		explicit Scope(TypeProvider const& _provider);
+		~Scope();
+
+	private:
+		TypeProvider const* m_previous;
+	};
+
+	static std::shared_ptr<BoolType const> boolean();
+	static std::shared_ptr<IntegerType const> integer(
+		unsigned _bits,
+		IntegerType::Modifier _modifier = IntegerType::Modifier::Unsigned
+	);
+	static std::shared_ptr<IntegerType const> uint256() { return integer(256); }
+	static std::shared_ptr<FixedBytesType const> fixedBytes(unsigned _bytes);
+	static std::shared_ptr<FixedPointType const> fixedPoint(
+		unsigned _totalBits,
+		unsigned _fractionalDigits,
+		FixedPointType::Modifier _modifier = FixedPointType::Modifier::Unsigned
+	);
+	static std::shared_ptr<AddressType const> address(StateMutability _stateMutability = StateMutability::NonPayable);
+	static std::shared_ptr<AddressType const> payableAddress() { return address(StateMutability::Payable); }
+
+private:
+	/// @returns the provider that is active for the current thread, if any.
+	static TypeProvider const* active();
+
+	std::shared_ptr<BoolType const> m_boolean;
+	/// Indexed by number of bytes minus one and signedness.
+	std::array<std::array<std::shared_ptr<IntegerType const>, 2>, 32> m_integers;
+	/// Indexed by number of bytes minus one.
+	std::array<std::shared_ptr<FixedBytesType const>, 32> m_fixedBytes;
+	/// Indexed by payability.
+	std::array<std::shared_ptr<AddressType const>, 2> m_addresses;
+};
+
+}
+}
@@ -23,6 +23,7 @@
 #include <libsolidity/ast/Types.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
 
 #include <libdevcore/Algorithms.h>
 #include <libdevcore/CommonData.h>
@@ -149,6 +150,12 @@ bool fitsIntoBits(bigint const& _value, unsigned _bits, bool _signed)
 
 }
 
+recursive_mutex& dev::solidity::lazyInitialisationMutex()
+{
+	static recursive_mutex s_mutex;
+	return s_mutex;
+}
+
 void StorageOffsets::computeOffsets(TypePointers const& _types)
 {
 	bigint slotOffset = 0;
@@ -200,6 +207,7 @@ void MemberList::combine(MemberList const & _other)
 
 pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name) const
 {
+	lock_guard<recursive_mutex> lock(lazyInitialisationMutex());
 	if (!m_storageOffsets)
 	{
 		TypePointers memberTypes;
@@ -217,6 +225,7 @@ pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name)
 
 u256 const& MemberList::storageSize() const
 {
+	lock_guard<recursive_mutex> lock(lazyInitialisationMutex());
 	// trigger lazy computation
 	memberStorageOffset("");
 	return m_storageOffsets->storageSize();
@@ -302,29 +311,29 @@ TypePointer Type::fromElementaryTypeName(ElementaryTypeNameToken const& _type)
 	switch (token)
 	{
 	case Token::IntM:
-		return make_shared<IntegerType>(m, IntegerType::Modifier::Signed);
+		return TypeProvider::integer(m, IntegerType::Modifier::Signed);
 	case Token::UIntM:
-		return make_shared<IntegerType>(m, IntegerType::Modifier::Unsigned);
+		return TypeProvider::integer(m, IntegerType::Modifier::Unsigned);
 	case Token::BytesM:
-		return make_shared<FixedBytesType>(m);
+		return TypeProvider::fixedBytes(m);
 	case Token::FixedMxN:
-		return make_shared<FixedPointType>(m, n, FixedPointType::Modifier::Signed);
+		return TypeProvider::fixedPoint(m, n, FixedPointType::Modifier::Signed);
 	case Token::UFixedMxN:
-		return make_shared<FixedPointType>(m, n, FixedPointType::Modifier::Unsigned);
+		return TypeProvider::fixedPoint(m, n, FixedPointType::Modifier::Unsigned);
 	case Token::Int:
-		return make_shared<IntegerType>(256, IntegerType::Modifier::Signed);
+		return TypeProvider::integer(256, IntegerType::Modifier::Signed);
 	case Token::UInt:
-		return make_shared<IntegerType>(256, IntegerType::Modifier::Unsigned);
+		return TypeProvider::integer(256, IntegerType::Modifier::Unsigned);
 	case Token::Fixed:
-		return make_shared<FixedPointType>(128, 18, FixedPointType::Modifier::Signed);
+		return TypeProvider::fixedPoint(128, 18, FixedPointType::Modifier::Signed);
 	case Token::UFixed:
-		return make_shared<FixedPointType>(128, 18, FixedPointType::Modifier::Unsigned);
+		return TypeProvider::fixedPoint(128, 18, FixedPointType::Modifier::Unsigned);
 	case Token::Byte:
-		return make_shared<FixedBytesType>(1);
+		return TypeProvider::fixedBytes(1);
 	case Token::Address:
-		return make_shared<AddressType>(StateMutability::NonPayable);
+		return TypeProvider::address();
 	case Token::Bool:
-		return make_shared<BoolType>();
+		return TypeProvider::boolean();
 	case Token::Bytes:
 		return make_shared<ArrayType>(DataLocation::Storage);
 	case Token::String:
@@ -368,11 +377,11 @@ TypePointer Type::fromElementaryTypeName(string const& _name)
 		if (nameParts.size() == 2)
 		{
 			if (nameParts[1] == "payable")
-				return make_shared<AddressType>(StateMutability::Payable);
+				return TypeProvider::payableAddress();
 			else
 				solAssert(false, "Invalid state mutability for address type: " + nameParts[1]);
 		}
-		return make_shared<AddressType>(StateMutability::NonPayable);
+		return TypeProvider::address();
 	}
 	else
 	{
@@ -387,7 +396,7 @@ TypePointer Type::forLiteral(Literal const& _literal)
 	{
 	case Token::TrueLiteral:
 	case Token::FalseLiteral:
-		return make_shared<BoolType>();
+		return TypeProvider::boolean();
 	case Token::Number:
 		return RationalNumberType::forLiteral(_literal);
 	case Token::StringLiteral:
@@ -411,6 +420,7 @@ TypePointer Type::commonType(TypePointer const& _a, TypePointer const& _b)
 
 MemberList const& Type::members(ContractDefinition const* _currentScope) const
 {
+	lock_guard<recursive_mutex> lock(lazyInitialisationMutex());
 	if (!m_members[_currentScope])
 	{
 		MemberList::MemberMap members = nativeMembers(_currentScope);
@@ -551,7 +561,7 @@ bool AddressType::operator==(Type const& _other) const
 MemberList::MemberMap AddressType::nativeMembers(ContractDefinition const*) const
 {
 	MemberList::MemberMap members = {
-		{"balance", make_shared<IntegerType>(256)},
+		{"balance", TypeProvider::uint256()},
 		{"call", make_shared<FunctionType>(strings{"bytes memory"}, strings{"bool", "bytes memory"}, FunctionType::Kind::BareCall, false, StateMutability::Payable)},
 		{"callcode", make_shared<FunctionType>(strings{"bytes memory"}, strings{"bool", "bytes memory"}, FunctionType::Kind::BareCallCode, false, StateMutability::Payable)},
 		{"delegatecall", make_shared<FunctionType>(strings{"bytes memory"}, strings{"bool", "bytes memory"}, FunctionType::Kind::BareDelegateCall, false)},
@@ -807,9 +817,9 @@ TypeResult FixedPointType::binaryOperatorResult(Token _operator, TypePointer con
 	return commonType;
 }
 
-std::shared_ptr<IntegerType> FixedPointType::asIntegerType() const
+std::shared_ptr<IntegerType const> FixedPointType::asIntegerType() const
 {
-	return make_shared<IntegerType>(numBits(), isSigned() ? IntegerType::Modifier::Signed : IntegerType::Modifier::Unsigned);
+	return TypeProvider::integer(numBits(), isSigned() ? IntegerType::Modifier::Signed : IntegerType::Modifier::Unsigned);
 }
 
 tuple<bool, rational> RationalNumberType::parseRational(string const& _value)
@@ -866,7 +876,7 @@ TypePointer RationalNumberType::forLiteral(Literal const& _literal)
 		{
 			size_t const digitCount = _literal.valueWithoutUnderscores().length() - 2;
 			if (digitCount % 2 == 0 && (digitCount / 2) <= 32)
-				compatibleBytesType = make_shared<FixedBytesType>(digitCount / 2);
+				compatibleBytesType = TypeProvider::fixedBytes(digitCount / 2);
 		}
 
 		return make_shared<RationalNumberType>(get<1>(validLiteral), compatibleBytesType);
@@ -1320,7 +1330,7 @@ shared_ptr<IntegerType const> RationalNumberType::integerType() const
 	if (value > u256(-1))
 		return shared_ptr<IntegerType const>();
 	else
-		return make_shared<IntegerType>(
+		return TypeProvider::integer(
 			max(bytesRequired(value), 1u) * 8,
 			negative ? IntegerType::Modifier::Signed : IntegerType::Modifier::Unsigned
 		);
@@ -1357,7 +1367,7 @@ shared_ptr<FixedPointType const> RationalNumberType::fixedPointType() const
 	unsigned totalBits = max(bytesRequired(v), 1u) * 8;
 	solAssert(totalBits <= 256, "");
 
-	return make_shared<FixedPointType>(
+	return TypeProvider::fixedPoint(
 		totalBits, fractionalDigits,
 		negative ? FixedPointType::Modifier::Signed : FixedPointType::Modifier::Unsigned
 	);
@@ -1473,7 +1483,7 @@ TypeResult FixedBytesType::binaryOperatorResult(Token _operator, TypePointer con
 
 MemberList::MemberMap FixedBytesType::nativeMembers(ContractDefinition const*) const
 {
-	return MemberList::MemberMap{MemberList::Member{"length", make_shared<IntegerType>(8)}};
+	return MemberList::MemberMap{MemberList::Member{"length", TypeProvider::integer(8)}};
 }
 
 string FixedBytesType::richIdentifier() const
@@ -1619,6 +1629,13 @@ string ReferenceType::identifierLocationSuffix() const
 	return id;
 }
 
+ArrayType::ArrayType(DataLocation _location, bool _isString):
+	ReferenceType(_location),
+	m_arrayKind(_isString ? ArrayKind::String : ArrayKind::Bytes),
+	m_baseType(TypeProvider::fixedBytes(1))
+{
+}
+
 BoolResult ArrayType::isImplicitlyConvertibleTo(Type const& _convertTo) const
 {
 	if (_convertTo.category() != category())
@@ -1831,12 +1848,12 @@ MemberList::MemberMap ArrayType::nativeMembers(ContractDefinition const*) const
 	MemberList::MemberMap members;
 	if (!isString())
 	{
-		members.emplace_back("length", make_shared<IntegerType>(256));
+		members.emplace_back("length", TypeProvider::uint256());
 		if (isDynamicallySized() && location() == DataLocation::Storage)
 		{
 			members.emplace_back("push", make_shared<FunctionType>(
 				TypePointers{baseType()},
-				TypePointers{make_shared<IntegerType>(256)},
+				TypePointers{TypeProvider::uint256()},
 				strings{string()},
 				strings{string()},
 				isByteArray() ? FunctionType::Kind::ByteArrayPush : FunctionType::Kind::ArrayPush
@@ -1856,7 +1873,7 @@ MemberList::MemberMap ArrayType::nativeMembers(ContractDefinition const*) const
 TypePointer ArrayType::encodingType() const
 {
 	if (location() == DataLocation::Storage)
-		return make_shared<IntegerType>(256);
+		return TypeProvider::uint256();
 	else
 		return this->copyForLocation(DataLocation::Memory, true);
 }
@@ -1864,13 +1881,14 @@ TypePointer ArrayType::encodingType() const
 TypePointer ArrayType::decodingType() const
 {
 	if (location() == DataLocation::Storage)
-		return make_shared<IntegerType>(256);
+		return TypeProvider::uint256();
 	else
 		return shared_from_this();
 }
 
 TypeResult ArrayType::interfaceType(bool _inLibrary) const
 {
+	lock_guard<recursive_mutex> lock(lazyInitialisationMutex());
 	if (_inLibrary && m_interfaceType_library.is_initialized())
 		return *m_interfaceType_library;
 
@@ -1922,6 +1940,13 @@ TypePointer ArrayType::copyForLocation(DataLocation _location, bool _isPointer)
 	return copy;
 }
 
+TypePointer ContractType::encodingType() const
+{
+	if (isSuper())
+		return TypePointer{};
+	return TypeProvider::address(isPayable() ? StateMutability::Payable : StateMutability::NonPayable);
+}
+
 string ContractType::richIdentifier() const
 {
 	return (m_super ? "t_super" : "t_contract") + parenthesizeUserIdentifier(m_contract.name()) + to_string(m_contract.id());
@@ -1995,6 +2020,7 @@ MemberList::MemberMap ContractType::nativeMembers(ContractDefinition const* _con
 
 shared_ptr<FunctionType const> const& ContractType::newExpressionType() const
 {
+	lock_guard<recursive_mutex> lock(lazyInitialisationMutex());
 	if (!m_constructorType)
 		m_constructorType = FunctionType::newExpressionType(m_contract);
 	return m_constructorType;
@@ -2134,8 +2160,14 @@ MemberList::MemberMap StructType::nativeMembers(ContractDefinition const*) const
 	return members;
 }
 
+TypePointer StructType::encodingType() const
+{
+	return location() == DataLocation::Storage ? TypeProvider::uint256() : shared_from_this();
+}
+
 TypeResult StructType::interfaceType(bool _inLibrary) const
 {
+	lock_guard<recursive_mutex> lock(lazyInitialisationMutex());
 	if (_inLibrary && m_interfaceType_library.is_initialized())
 		return *m_interfaceType_library;
 
@@ -2225,6 +2257,14 @@ TypeResult StructType::interfaceType(bool _inLibrary) const
 	return *m_interfaceType;
 }
 
+bool StructType::recursive() const
+{
+	lock_guard<recursive_mutex> lock(lazyInitialisationMutex());
+	if (!m_recursive.is_initialized())
+		interfaceType(false);
+	return m_recursive.get();
+}
+
 TypePointer StructType::copyForLocation(DataLocation _location, bool _isPointer) const
 {
 	auto copy = make_shared<StructType>(m_struct, _location);
@@ -2349,6 +2389,11 @@ string EnumType::canonicalName() const
 	return m_enum.annotation().canonicalName;
 }
 
+TypePointer EnumType::encodingType() const
+{
+	return TypeProvider::integer(8 * int(storageBytes()));
+}
+
 size_t EnumType::numberOfMembers() const
 {
 	return m_enum.members().size();
@@ -2515,7 +2560,7 @@ FunctionType::FunctionType(VariableDeclaration const& _varDecl):
 				break;
 			returnType = arrayType->baseType();
 			m_parameterNames.emplace_back("");
-			m_parameterTypes.push_back(make_shared<IntegerType>(256));
+			m_parameterTypes.push_back(TypeProvider::uint256());
 		}
 		else
 			break;
@@ -2952,7 +2997,7 @@ MemberList::MemberMap FunctionType::nativeMembers(ContractDefinition const*) con
 	{
 		MemberList::MemberMap members;
 		if (m_kind == Kind::External)
-			members.emplace_back("selector", make_shared<FixedBytesType>(4));
+			members.emplace_back("selector", TypeProvider::fixedBytes(4));
 		if (m_kind != Kind::BareDelegateCall)
 		{
 			if (isPayable())
@@ -3303,6 +3348,11 @@ string MappingType::canonicalName() const
 	return "mapping(" + keyType()->canonicalName() + " => " + valueType()->canonicalName() + ")";
 }
 
+TypePointer MappingType::encodingType() const
+{
+	return TypeProvider::uint256();
+}
+
 TypeResult MappingType::interfaceType(bool _inLibrary) const
 {
 	solAssert(keyType()->interfaceType(_inLibrary).get(), "Must be an elementary type!");
@@ -3508,25 +3558,25 @@ MemberList::MemberMap MagicType::nativeMembers(ContractDefinition const*) const
 	{
 	case Kind::Block:
 		return MemberList::MemberMap({
-			{"coinbase", make_shared<AddressType>(StateMutability::Payable)},
-			{"timestamp", make_shared<IntegerType>(256)},
+			{"coinbase", TypeProvider::payableAddress()},
+			{"timestamp", TypeProvider::uint256()},
 			{"blockhash", make_shared<FunctionType>(strings{"uint"}, strings{"bytes32"}, FunctionType::Kind::BlockHash, false, StateMutability::View)},
-			{"difficulty", make_shared<IntegerType>(256)},
-			{"number", make_shared<IntegerType>(256)},
-			{"gaslimit", make_shared<IntegerType>(256)}
+			{"difficulty", TypeProvider::uint256()},
+			{"number", TypeProvider::uint256()},
+			{"gaslimit", TypeProvider::uint256()}
 		});
 	case Kind::Message:
 		return MemberList::MemberMap({
-			{"sender", make_shared<AddressType>(StateMutability::Payable)},
-			{"gas", make_shared<IntegerType>(256)},
-			{"value", make_shared<IntegerType>(256)},
+			{"sender", TypeProvider::payableAddress()},
+			{"gas", TypeProvider::uint256()},
+			{"value", TypeProvider::uint256()},
 			{"data", make_shared<ArrayType>(DataLocation::CallData)},
-			{"sig", make_shared<FixedBytesType>(4)}
+			{"sig", TypeProvider::fixedBytes(4)}
 		});
 	case Kind::Transaction:
 		return MemberList::MemberMap({
-			{"origin", make_shared<AddressType>(StateMutability::Payable)},
-			{"gasprice", make_shared<IntegerType>(256)}
+			{"origin", TypeProvider::payableAddress()},
+			{"gasprice", TypeProvider::uint256()}
 		});
 	case Kind::ABI:
 		return MemberList::MemberMap({
@@ -3549,7 +3599,7 @@ MemberList::MemberMap MagicType::nativeMembers(ContractDefinition const*) const
 				StateMutability::Pure
 			)},
 			{"encodeWithSelector", make_shared<FunctionType>(
-				TypePointers{make_shared<FixedBytesType>(4)},
+				TypePointers{TypeProvider::fixedBytes(4)},
 				TypePointers{make_shared<ArrayType>(DataLocation::Memory)},
 				strings{1, ""},
 				strings{1, ""},
@@ -3623,3 +3673,8 @@ TypePointer MagicType::typeArgument() const
 	solAssert(m_typeArgument, "");
 	return m_typeArgument;
 }
+
+TypePointer InaccessibleDynamicType::decodingType() const
+{
+	return TypeProvider::uint256();
+}
@@ -37,6 +37,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 
@@ -54,6 +55,10 @@ using rational = boost::rational<dev::bigint>;
 using TypeResult = Result<TypePointer>;
 using BoolResult = Result<bool>;
 
+/// @returns the mutex guarding the lazily filled caches of types and AST nodes.
+/// Types and AST nodes are shared between contracts that are compiled concurrently.
+std::recursive_mutex& lazyInitialisationMutex();
+
 inline rational makeRational(bigint const& _numerator, bigint const& _denominator)
 {
 	solAssert(_denominator != 0, "division by zero");
@@ -462,7 +467,7 @@ public:
 	bigint minIntegerValue() const;
 
 	/// @returns the smallest integer type that can hold this type with fractional parts shifted to integers.
-	std::shared_ptr<IntegerType> asIntegerType() const;
+	std::shared_ptr<IntegerType const> asIntegerType() const;
 
 private:
 	unsigned m_totalBits;
@@ -692,12 +697,7 @@ public:
 	Category category() const override { return Category::Array; }
 
 	/// Constructor for a byte array ("bytes") and string.
-	explicit ArrayType(DataLocation _location, bool _isString = false):
-		ReferenceType(_location),
-		m_arrayKind(_isString ? ArrayKind::String : ArrayKind::Bytes),
-		m_baseType(std::make_shared<FixedBytesType>(1))
-	{
-	}
+	explicit ArrayType(DataLocation _location, bool _isString = false);
 	/// Constructor for a dynamically sized array type ("type[]")
 	ArrayType(DataLocation _location, TypePointer const& _baseType):
 		ReferenceType(_location),
@@ -795,12 +795,7 @@ public:
 	std::string canonicalName() const override;
 
 	MemberList::MemberMap nativeMembers(ContractDefinition const* _currentScope) const override;
-	TypePointer encodingType() const override
-	{
-		if (isSuper())
-			return TypePointer{};
-		return std::make_shared<AddressType>(isPayable() ? StateMutability::Payable : StateMutability::NonPayable);
-	}
+	TypePointer encodingType() const override;
 	TypeResult interfaceType(bool _inLibrary) const override
 	{
 		if (isSuper())
@@ -851,21 +846,10 @@ public:
 	std::string toString(bool _short) const override;
 
 	MemberList::MemberMap nativeMembers(ContractDefinition const* _currentScope) const override;
-	TypePointer encodingType() const override
-	{
-		return location() == DataLocation::Storage ? std::make_shared<IntegerType>(256) : shared_from_this();
-	}
+	TypePointer encodingType() const override;
 	TypeResult interfaceType(bool _inLibrary) const override;
 
-	bool recursive() const
-	{
-		if (m_recursive.is_initialized())
-			return m_recursive.get();
-
-		interfaceType(false);
-
-		return m_recursive.get();
-	}
+	bool recursive() const;
 
 	TypePointer copyForLocation(DataLocation _location, bool _isPointer) const override;
 
@@ -917,10 +901,7 @@ public:
 	bool isValueType() const override { return true; }
 
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
-	TypePointer encodingType() const override
-	{
-		return std::make_shared<IntegerType>(8 * int(storageBytes()));
-	}
+	TypePointer encodingType() const override;
 	TypeResult interfaceType(bool _inLibrary) const override
 	{
 		return _inLibrary ? shared_from_this() : encodingType();
@@ -1239,10 +1220,7 @@ public:
 	std::string canonicalName() const override;
 	bool canLiveOutsideStorage() const override { return false; }
 	TypeResult binaryOperatorResult(Token, TypePointer const&) const override { return TypePointer(); }
-	TypePointer encodingType() const override
-	{
-		return std::make_shared<IntegerType>(256);
-	}
+	TypePointer encodingType() const override;
 	TypeResult interfaceType(bool _inLibrary) const override;
 	bool dataStoredIn(DataLocation _location) const override { return _location == DataLocation::Storage; }
 	/// Cannot be stored in memory, but just in case.
@@ -1399,7 +1377,7 @@ public:
 	unsigned sizeOnStack() const override { return 1; }
 	bool hasSimpleZeroValueInMemory() const override { solAssert(false, ""); }
 	std::string toString(bool) const override { return "inaccessible dynamic type"; }
-	TypePointer decodingType() const override { return std::make_shared<IntegerType>(256); }
+	TypePointer decodingType() const override;
 };
 
 }
@@ -24,6 +24,7 @@
 
 #include <libsolidity/codegen/ContractCompiler.h>
 #include <libevmasm/Assembly.h>
+#include <libdevcore/Profiler.h>
 
 using namespace std;
 using namespace dev;
@@ -35,20 +36,24 @@ void Compiler::compileContract(
 	bytes const& _metadata
 )
 {
-	ContractCompiler runtimeCompiler(nullptr, m_runtimeContext, m_optimiserSettings);
-	runtimeCompiler.compileContract(_contract, _otherCompilers);
-	m_runtimeContext.appendAuxiliaryData(_metadata);
-
-	// This might modify m_runtimeContext because it can access runtime functions at
-	// creation time.
-	OptimiserSettings creationSettings{m_optimiserSettings};
-	// The creation code will be executed at most once, so we modify the optimizer
-	// settings accordingly.
-	creationSettings.expectedExecutionsPerDeployment = 1;
-	ContractCompiler creationCompiler(&runtimeCompiler, m_context, creationSettings);
-	m_runtimeSub = creationCompiler.compileConstructor(_contract, _otherCompilers);
-
-	m_context.optimise(m_optimiserSettings);
+	{
+		ProfilerPhase phase("codegen/ContractCompiler");
+		ContractCompiler runtimeCompiler(nullptr, m_runtimeContext, m_optimiserSettings);
+		runtimeCompiler.compileContract(_contract, _otherCompilers);
+		m_runtimeContext.appendAuxiliaryData(_metadata);
+
+		// This might modify m_runtimeContext because it can access runtime functions at
+		// creation time.
+		OptimiserSettings creationSettings{m_optimiserSettings};
+		// The creation code will be executed at most once, so we modify the optimizer
+		// settings accordingly.
+		creationSettings.expectedExecutionsPerDeployment = 1;
+		ContractCompiler creationCompiler(&runtimeCompiler, m_context, creationSettings);
+		m_runtimeSub = creationCompiler.compileConstructor(_contract, _otherCompilers);
+	}
+
+	ProfilerPhase phase("evmasm/optimise");
+	m_context.optimise(m_optimiserSettings, m_parallelism);
 }
 
 std::shared_ptr<eth::Assembly> Compiler::runtimeAssemblyPtr() const
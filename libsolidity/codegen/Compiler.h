@@ -35,8 +35,10 @@ namespace solidity {
 class Compiler
 {
 public:
-	explicit Compiler(langutil::EVMVersion _evmVersion, OptimiserSettings _optimiserSettings):
+	/// @param _parallelism maximal number of sub-assemblies optimised concurrently.
+	explicit Compiler(langutil::EVMVersion _evmVersion, OptimiserSettings _optimiserSettings, unsigned _parallelism = 1):
 		m_optimiserSettings(std::move(_optimiserSettings)),
+		m_parallelism(_parallelism),
 		m_runtimeContext(_evmVersion),
 		m_context(_evmVersion, &m_runtimeContext)
 	{ }
@@ -58,15 +60,14 @@ public:
 	eth::LinkerObject assembledObject() const { return m_context.assembledObject(); }
 	/// @returns Only the runtime object (without constructor).
 	eth::LinkerObject runtimeObject() const { return m_context.assembledRuntimeObject(m_runtimeSub); }
-	/// @arg _sourceCodes is the map of input files to source code strings
-	std::string assemblyString(StringMap const& _sourceCodes = StringMap()) const
+	/// @arg _sourceNames the sources whose code is shown next to the items referring to them
+	std::string assemblyString(std::set<std::string> const& _sourceNames = {}) const
 	{
-		return m_context.assemblyString(_sourceCodes);
+		return m_context.assemblyString(_sourceNames);
 	}
-	/// @arg _sourceCodes is the map of input files to source code strings
-	Json::Value assemblyJSON(StringMap const& _sourceCodes = StringMap()) const
+	Json::Value assemblyJSON() const
 	{
-		return m_context.assemblyJSON(_sourceCodes);
+		return m_context.assemblyJSON();
 	}
 	/// @returns Assembly items of the normal compiler context
 	eth::AssemblyItems const& assemblyItems() const { return m_context.assembly().items(); }
@@ -79,6 +80,7 @@ public:
 
 private:
 	OptimiserSettings const m_optimiserSettings;
+	unsigned const m_parallelism;
 	CompilerContext m_runtimeContext;
 	size_t m_runtimeSub = size_t(-1); ///< Identifier of the runtime sub-assembly, if present.
 	CompilerContext m_context;
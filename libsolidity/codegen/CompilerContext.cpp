@@ -427,7 +427,9 @@ void CompilerContext::appendInlineAssembly(
 			*parserResult,
 			analysisInfo,
 			_optimiserSettings.optimizeStackAllocation,
-			externallyUsedIdentifiers
+			externallyUsedIdentifiers,
+			_optimiserSettings.yulOptimiserSteps,
+			_optimiserSettings.optimizeFunctionsSeparately
 		);
 		analysisInfo = yul::AsmAnalysisInfo{};
 		if (!yul::AsmAnalyzer(
@@ -498,7 +500,7 @@ void CompilerContext::updateSourceLocation()
 eth::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(OptimiserSettings const& _settings)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	eth::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, m_evmVersion, 0};
+	eth::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, m_evmVersion, 0, 1};
 	asmSettings.isCreation = true;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
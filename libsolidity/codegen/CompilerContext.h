@@ -223,8 +223,13 @@ public:
 	/// Appends arbitrary data to the end of the bytecode.
 	void appendAuxiliaryData(bytes const& _data) { m_asm->appendAuxiliaryDataToEnd(_data); }
 
-	/// Run optimisation step.
-	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(translateOptimiserSettings(_settings)); }
+	/// Run optimisation step, optimising up to @a _jobs sub-assemblies concurrently.
+	void optimise(OptimiserSettings const& _settings, unsigned _jobs = 1)
+	{
+		eth::Assembly::OptimiserSettings asmSettings = translateOptimiserSettings(_settings);
+		asmSettings.jobs = _jobs;
+		m_asm->optimise(asmSettings);
+	}
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
@@ -237,16 +242,15 @@ public:
 	/// Should be avoided except when adding sub-assemblies.
 	std::shared_ptr<eth::Assembly> assemblyPtr() const { return m_asm; }
 
-	/// @arg _sourceCodes is the map of input files to source code strings
-	std::string assemblyString(StringMap const& _sourceCodes = StringMap()) const
+	/// @arg _sourceNames the sources whose code is shown next to the items referring to them
+	std::string assemblyString(std::set<std::string> const& _sourceNames = {}) const
 	{
-		return m_asm->assemblyString(_sourceCodes);
+		return m_asm->assemblyString(_sourceNames);
 	}
 
-	/// @arg _sourceCodes is the map of input files to source code strings
-	Json::Value assemblyJSON(StringMap const& _sourceCodes = StringMap()) const
+	Json::Value assemblyJSON() const
 	{
-		return m_asm->assemblyJSON(_sourceCodes);
+		return m_asm->assemblyJSON();
 	}
 
 	eth::LinkerObject const& assembledObject() const { return m_asm->assemble(); }
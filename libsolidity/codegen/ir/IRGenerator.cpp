@@ -45,7 +45,12 @@ pair<string, string> IRGenerator::run(ContractDefinition const& _contract)
 	// TODO Would be nice to pretty-print this while retaining comments.
 	string ir = generateIR(_contract);
 
-	yul::AssemblyStack asmStack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
+	yul::AssemblyStack asmStack(
+		m_evmVersion,
+		yul::AssemblyStack::Language::StrictAssembly,
+		m_optimiserSettings,
+		m_parallelism
+	);
 	if (!asmStack.parseAndAnalyze("", ir))
 	{
 		string errorMessage;
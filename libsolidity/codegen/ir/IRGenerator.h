@@ -39,9 +39,11 @@ class SourceUnit;
 class IRGenerator
 {
 public:
-	IRGenerator(langutil::EVMVersion _evmVersion, OptimiserSettings _optimiserSettings):
+	/// @param _parallelism maximal number of functions optimised concurrently, see AssemblyStack.
+	IRGenerator(langutil::EVMVersion _evmVersion, OptimiserSettings _optimiserSettings, unsigned _parallelism = 1):
 		m_evmVersion(_evmVersion),
 		m_optimiserSettings(_optimiserSettings),
+		m_parallelism(_parallelism),
 		m_context(_evmVersion, std::move(_optimiserSettings)),
 		m_utils(_evmVersion, m_context.functionCollector())
 	{}
@@ -69,6 +71,7 @@ private:
 
 	langutil::EVMVersion const m_evmVersion;
 	OptimiserSettings const m_optimiserSettings;
+	unsigned const m_parallelism;
 
 	IRGenerationContext m_context;
 	YulUtilFunctions m_utils;
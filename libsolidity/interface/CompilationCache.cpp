@@ -0,0 +1,213 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Persistent cache of compiled contracts shared between compiler invocations.
+ */
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libdevcore/CommonData.h>
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/Exceptions.h>
+#include <libdevcore/JSON.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+string const c_entryExtension = ".json";
+
+Json::Value objectToJson(eth::LinkerObject const& _object)
+{
+	Json::Value ret(Json::objectValue);
+	ret["bytecode"] = toHex(_object.bytecode);
+	ret["linkReferences"] = Json::objectValue;
+	for (auto const& reference: _object.linkReferences)
+		ret["linkReferences"][to_string(reference.first)] = reference.second;
+	return ret;
+}
+
+bool objectFromJson(Json::Value const& _json, eth::LinkerObject& o_object)
+{
+	if (!_json["bytecode"].isString() || !_json["linkReferences"].isObject())
+		return false;
+	o_object.bytecode = fromHex(_json["bytecode"].asString(), WhenError::Throw);
+	o_object.linkReferences.clear();
+	for (auto const& offset: _json["linkReferences"].getMemberNames())
+	{
+		if (!_json["linkReferences"][offset].isString())
+			return false;
+		o_object.linkReferences[stoul(offset)] = _json["linkReferences"][offset].asString();
+	}
+	return true;
+}
+
+}
+
+CompilationCache::CompilationCache(string const& _directory, uint64_t _maxSize):
+	m_directory(_directory),
+	m_maxSize(_maxSize)
+{
+	fs::create_directories(m_directory);
+}
+
+boost::optional<CompilationCache::Entry> CompilationCache::load(h256 const& _key)
+{
+	lock_guard<mutex> lock(m_mutex);
+
+	fs::path path = entryPath(_key);
+	boost::system::error_code error;
+	if (!fs::is_regular_file(path, error))
+		return boost::none;
+
+	Json::Value json;
+	if (!jsonParseStrict(readFileAsString(path.string()), json) || !json.isObject())
+		return boost::none;
+
+	Entry entry;
+	try
+	{
+		if (
+			!objectFromJson(json["object"], entry.object) ||
+			!objectFromJson(json["runtimeObject"], entry.runtimeObject) ||
+			!json["sourceMapping"].isString() ||
+			!json["runtimeSourceMapping"].isString() ||
+			!json["assembly"].isString()
+		)
+			return boost::none;
+	}
+	catch (BadHexCharacter const&)
+	{
+		return boost::none;
+	}
+	catch (logic_error const&)
+	{
+		// Thrown by stoul for invalid offsets.
+		return boost::none;
+	}
+	entry.sourceMapping = json["sourceMapping"].asString();
+	entry.runtimeSourceMapping = json["runtimeSourceMapping"].asString();
+	entry.assembly = json["assembly"].asString();
+	entry.assemblyJSON = json["assemblyJSON"];
+
+	// Mark as recently used.
+	fs::last_write_time(path, time(nullptr), error);
+	return entry;
+}
+
+void CompilationCache::store(h256 const& _key, Entry const& _entry)
+{
+	Json::Value json(Json::objectValue);
+	json["object"] = objectToJson(_entry.object);
+	json["runtimeObject"] = objectToJson(_entry.runtimeObject);
+	json["sourceMapping"] = _entry.sourceMapping;
+	json["runtimeSourceMapping"] = _entry.runtimeSourceMapping;
+	json["assembly"] = _entry.assembly;
+	json["assemblyJSON"] = _entry.assemblyJSON;
+
+	lock_guard<mutex> lock(m_mutex);
+
+	// Write to a temporary file first, so that other processes never read partial entries.
+	boost::system::error_code error;
+	fs::path temporaryPath = m_directory / fs::unique_path("%%%%-%%%%-%%%%-%%%%.tmp", error);
+	if (error)
+		return;
+	{
+		ofstream file(temporaryPath.string(), ios::binary);
+		file << jsonCompactPrint(json);
+		if (!file)
+		{
+			fs::remove(temporaryPath, error);
+			return;
+		}
+	}
+	fs::path path = entryPath(_key);
+	fs::rename(temporaryPath, path, error);
+	if (error)
+	{
+		fs::remove(temporaryPath, error);
+		return;
+	}
+	m_storedPaths.insert(path);
+}
+
+fs::path CompilationCache::entryPath(h256 const& _key) const
+{
+	return m_directory / (_key.hex() + c_entryExtension);
+}
+
+void CompilationCache::evict()
+{
+	lock_guard<mutex> lock(m_mutex);
+
+	set<fs::path> storedPaths;
+	swap(storedPaths, m_storedPaths);
+
+	struct EntryFile
+	{
+		fs::path path;
+		time_t lastUsed;
+		uint64_t size;
+	};
+	vector<EntryFile> entries;
+	uint64_t totalSize = 0;
+
+	boost::system::error_code error;
+	for (fs::directory_iterator it(m_directory, error), end; !error && it != end; it.increment(error))
+	{
+		fs::path const& path = it->path();
+		if (path.extension() != c_entryExtension)
+			continue;
+		uint64_t size = fs::file_size(path, error);
+		time_t lastUsed = fs::last_write_time(path, error);
+		if (error)
+		{
+			// Might have been removed by another process in the meantime.
+			error.clear();
+			continue;
+		}
+		entries.push_back(EntryFile{path, lastUsed, size});
+		totalSize += size;
+	}
+
+	if (totalSize <= m_maxSize)
+		return;
+
+	sort(entries.begin(), entries.end(), [](EntryFile const& _a, EntryFile const& _b) {
+		return _a.lastUsed < _b.lastUsed;
+	});
+	for (auto const& entry: entries)
+	{
+		if (totalSize <= m_maxSize)
+			break;
+		if (storedPaths.count(entry.path))
+			continue;
+		fs::remove(entry.path, error);
+		totalSize -= entry.size;
+	}
+}
@@ -0,0 +1,102 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Persistent cache of compiled contracts shared between compiler invocations.
+ */
+
+#pragma once
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libdevcore/FixedHash.h>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <json/json.h>
+
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Directory based cache of the results of compiling single contracts.
+ *
+ * Every entry is stored in its own file named after its key. The key has to
+ * cover everything that influences the result (see CompilerStack). Entries are
+ * evicted in least recently used order once the files in the directory exceed
+ * the configured size. Several processes can share the same directory.
+ *
+ * The cache is best-effort: I/O errors and corrupt entries are treated like
+ * missing entries.
+ */
+class CompilationCache: boost::noncopyable
+{
+public:
+	/// The stored results. Objects are stored before libraries are linked.
+	struct Entry
+	{
+		eth::LinkerObject object;
+		eth::LinkerObject runtimeObject;
+		std::string sourceMapping;
+		std::string runtimeSourceMapping;
+		std::string assembly;
+		Json::Value assemblyJSON;
+	};
+
+	static std::uint64_t constexpr defaultMaxSize = 512 * 1024 * 1024;
+
+	/// Uses @a _directory, which is created if it does not exist, and keeps the
+	/// size of all entries below @a _maxSize bytes.
+	/// Throws boost::filesystem::filesystem_error if the directory cannot be created.
+	explicit CompilationCache(std::string const& _directory, std::uint64_t _maxSize = defaultMaxSize);
+
+	/// @returns the entry stored under @a _key, if any, and marks it as recently used.
+	boost::optional<Entry> load(h256 const& _key);
+
+	/// Stores @a _entry under @a _key, replacing any previous entry. The cache
+	/// can grow too large until the next call to evict().
+	void store(h256 const& _key, Entry const& _entry);
+
+	/// Removes the least recently used entries until the cache is small enough.
+	/// Has to be called once after storing all results of a compilation, since
+	/// it looks at every file in the directory.
+	/// Entries stored since the last call are kept: modification times only have
+	/// a resolution of one second, so they cannot be told apart from older entries.
+	void evict();
+
+private:
+	boost::filesystem::path entryPath(h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+	std::uint64_t m_maxSize;
+	/// Entries stored since the last eviction.
+	std::set<boost::filesystem::path> m_storedPaths;
+	/// Serializes the accesses of the threads of one process. Other processes
+	/// only ever see complete entries since they are written to a temporary
+	/// file first.
+	std::mutex m_mutex;
+};
+
+}
+}
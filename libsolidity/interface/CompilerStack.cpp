@@ -38,6 +38,8 @@
 #include <libsolidity/analysis/ViewPureChecker.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/formal/SMTGas.h>
 #include <libsolidity/interface/ABI.h>
@@ -49,6 +51,7 @@
 #include <libsolidity/codegen/ir/IRGenerator.h>
 
 #include <libyul/YulString.h>
+#include <libyul/optimiser/Suite.h>
 
 #include <liblangutil/Scanner.h>
 
@@ -56,10 +59,13 @@
 
 #include <libdevcore/SwarmHash.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/Profiler.h>
+#include <libdevcore/ThreadPool.h>
 
 #include <json/json.h>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/range/adaptor/reversed.hpp>
 
 using namespace std;
 using namespace dev;
@@ -123,6 +129,11 @@ void CompilerStack::setOptimiserSettings(OptimiserSettings _settings)
 	m_optimiserSettings = std::move(_settings);
 }
 
+void CompilerStack::setParallelism(unsigned _parallelism)
+{
+	m_parallelism = _parallelism == 0 ? ThreadPool::hardwareConcurrency() : _parallelism;
+}
+
 void CompilerStack::useMetadataLiteralSources(bool _metadataLiteralSources)
 {
 	if (m_stackState >= ParsingSuccessful)
@@ -149,33 +160,179 @@ void CompilerStack::reset(bool _keepSettings)
 		m_libraries.clear();
 		m_evmVersion = langutil::EVMVersion();
 		m_generateIR = false;
+		m_parallelism = 1;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
 	}
+	m_typeProvider.reset();
 	m_globalContext.reset();
+	m_retiredASTs.clear();
+	m_retiredNodeCount = 0;
 	m_scopes.clear();
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
 }
 
-void CompilerStack::setSources(StringMap const& _sources)
+void CompilerStack::setSources(StringMap _sources)
 {
 	if (m_stackState == SourcesSet)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot change sources once set."));
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set sources before parsing."));
+	for (auto& source: _sources)
+		m_sources[source.first].scanner = make_shared<Scanner>(CharStream(/*content*/std::move(source.second), /*name*/source.first));
+	m_stackState = SourcesSet;
+}
+
+namespace
+{
+
+/// Adds an offset to the IDs of all nodes of an AST.
+class NodeIDShifter: private ASTVisitor
+{
+public:
+	explicit NodeIDShifter(size_t _offset): m_offset(_offset) {}
+	void shift(SourceUnit& _sourceUnit) { _sourceUnit.accept(*this); }
+
+private:
+	bool visit(ImportDirective& _import) override
+	{
+		// The identifiers of the aliases are not visited as children of the import.
+		for (auto const& alias: _import.symbolAliases())
+			alias.first->setID(alias.first->id() + m_offset);
+		return visitNode(_import);
+	}
+	bool visitNode(ASTNode& _node) override
+	{
+		_node.setID(_node.id() + m_offset);
+		return true;
+	}
+
+	size_t m_offset;
+};
+
+}
+
+bool CompilerStack::updateSources(StringMap _sources)
+{
+	if (m_stackState < SourcesSet)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set sources before updating them."));
+
+	bool changed = false;
+	for (auto const& source: _sources)
+		if (
+			!m_sources.count(source.first) ||
+			m_sources.at(source.first).loadedViaCallback ||
+			m_sources.at(source.first).scanner->source() != source.second
+		)
+			changed = true;
+	if (!changed && m_stackState >= ParsingSuccessful)
+		return true;
+
+	size_t nodeCount = 0;
+	for (auto const& source: m_sources)
+		nodeCount += source.second.nodeIDCount;
+	if (m_stackState < AnalysisSuccessful || m_errorReporter.warningsDropped() || m_retiredNodeCount > nodeCount)
+	{
+		// The annotations might be incomplete, the errors of single sources are not known or
+		// the discarded ASTs use more memory than the current ones, so start from scratch.
+		StringMap sources;
+		for (auto const& source: m_sources)
+			if (!source.second.loadedViaCallback)
+				sources[source.first] = source.second.scanner->source();
+		for (auto& source: _sources)
+			sources[source.first] = std::move(source.second);
+		map<h256, string> smtlib2Responses = std::move(m_smtlib2Responses);
+		reset(true);
+		m_smtlib2Responses = std::move(smtlib2Responses);
+		setSources(std::move(sources));
+		return parse();
+	}
+
+	// A new compilation would read the sources loaded via the read callback again.
+	set<string> changedSources;
 	for (auto const& source: _sources)
-		m_sources[source.first].scanner = make_shared<Scanner>(CharStream(/*content*/source.second, /*name*/source.first));
+		if (!m_sources.count(source.first) || m_sources.at(source.first).scanner->source() != source.second)
+			changedSources.insert(source.first);
+	for (auto const& source: m_sources)
+		if (source.second.loadedViaCallback && !_sources.count(source.first))
+		{
+			ReadCallback::Result result{false, string()};
+			if (m_readFile)
+				result = m_readFile(source.first);
+			if (!result.success || result.responseOrErrorMessage != source.second.scanner->source())
+				changedSources.insert(source.first);
+		}
+
+	// Everything that (transitively) imports a changed source has to be parsed and analysed again.
+	map<string, set<string>> importingSources;
+	for (auto const& source: m_sources)
+		for (ASTPointer<ASTNode> const& node: source.second.ast->nodes())
+			if (ImportDirective const* import = dynamic_cast<ImportDirective const*>(node.get()))
+				importingSources[import->annotation().absolutePath].insert(source.first);
+	set<string> sourcesToParse;
+	vector<string> worklist(changedSources.begin(), changedSources.end());
+	while (!worklist.empty())
+	{
+		string sourceName = std::move(worklist.back());
+		worklist.pop_back();
+		if (!sourcesToParse.insert(sourceName).second)
+			continue;
+		for (string const& importingSource: importingSources[sourceName])
+			worklist.push_back(importingSource);
+	}
+
+	for (string const& sourceName: sourcesToParse)
+	{
+		if (!m_sources.count(sourceName))
+			continue;
+		retireAST(sourceName);
+		Source& source = m_sources.at(sourceName);
+		if (changedSources.count(sourceName) && !_sources.count(sourceName))
+			// Read again via the callback if it is still imported.
+			m_sources.erase(sourceName);
+		else
+		{
+			shared_ptr<Scanner> scanner = std::move(source.scanner);
+			bool loadedViaCallback = source.loadedViaCallback;
+			source.reset();
+			source.scanner = std::move(scanner);
+			source.loadedViaCallback = loadedViaCallback;
+		}
+	}
+	for (auto& source: _sources)
+	{
+		if (changedSources.count(source.first))
+			m_sources[source.first].scanner = make_shared<Scanner>(CharStream(std::move(source.second), source.first));
+		m_sources[source.first].loadedViaCallback = false;
+	}
+
+	// Bytecode is not kept, since compilation is not incremental.
+	for (auto& contract: m_contracts)
+	{
+		ContractDefinition const* definition = contract.second.contract;
+		contract.second = Contract();
+		contract.second.contract = definition;
+	}
+	m_unhandledSMTLib2Queries.clear();
+	m_sourceOrder.clear();
 	m_stackState = SourcesSet;
+	return parse();
 }
 
 bool CompilerStack::parse()
 {
 	if (m_stackState != SourcesSet)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call parse only after the SourcesSet state."));
+
 	m_errorReporter.clear();
 	ASTNode::resetID();
+	// The annotations of the ASTs kept by updateSources() refer to the types of the provider,
+	// so it is only replaced when the stack is reset.
+	if (!m_typeProvider)
+		m_typeProvider = make_shared<TypeProvider>();
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning("This is a pre-release compiler version, please do not use it in production.");
@@ -188,27 +345,72 @@ bool CompilerStack::parse()
 
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
-		sourcesToParse.push_back(s.first);
+		if (!s.second.loadedViaCallback)
+			sourcesToParse.push_back(s.first);
+	set<string> sourcesSeen(sourcesToParse.begin(), sourcesToParse.end());
 	for (size_t i = 0; i < sourcesToParse.size(); ++i)
 	{
-		string const& path = sourcesToParse[i];
+		string const path = sourcesToParse[i];
 		Source& source = m_sources[path];
-		source.scanner->reset();
-		source.ast = Parser(m_errorReporter).parse(source.scanner);
-		if (!source.ast)
-			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
+		if (source.analysed)
+		{
+			// The AST was kept by updateSources(). Its nodes get the IDs of a new compilation.
+			size_t const nodeIDOffset = ASTNode::lastID();
+			NodeIDShifter(nodeIDOffset - source.nodeIDOffset).shift(*source.ast);
+			source.nodeIDOffset = nodeIDOffset;
+			ASTNode::resetID(nodeIDOffset + source.nodeIDCount);
+			m_errorReporter.replay(source.errors.at("parsing"));
+		}
 		else
 		{
-			source.ast->annotation().path = path;
-			for (auto const& newSource: loadMissingSources(*source.ast, path))
+			ProfilerContext profilerContext(path);
+			ProfilerPhase profilerPhase("parsing");
+			size_t const errorCount = m_errorReporter.errors().size();
+			source.nodeIDOffset = ASTNode::lastID();
+			source.scanner->reset();
+			source.ast = Parser(m_errorReporter).parse(source.scanner);
+			source.nodeIDCount = ASTNode::lastID() - source.nodeIDOffset;
+			if (!source.ast)
+				solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
+			else
+			{
+				source.ast->annotation().path = path;
+				for (auto& newSource: loadMissingSources(*source.ast, path))
+				{
+					string const& newPath = newSource.first;
+					m_sources[newPath].scanner = make_shared<Scanner>(CharStream(std::move(newSource.second), newPath));
+					m_sources[newPath].loadedViaCallback = true;
+				}
+			}
+			source.errors["parsing"] = ErrorList(m_errorReporter.errors().begin() + errorCount, m_errorReporter.errors().end());
+		}
+
+		// Sources imported for the first time are parsed next, in the order of their names.
+		if (source.ast)
+		{
+			set<string> newImports;
+			for (ASTPointer<ASTNode> const& node: source.ast->nodes())
+				if (ImportDirective const* import = dynamic_cast<ImportDirective const*>(node.get()))
+					if (m_sources.count(import->annotation().absolutePath) && !sourcesSeen.count(import->annotation().absolutePath))
+						newImports.insert(import->annotation().absolutePath);
+			for (string const& newImport: newImports)
 			{
-				string const& newPath = newSource.first;
-				string const& newContents = newSource.second;
-				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
-				sourcesToParse.push_back(newPath);
+				sourcesSeen.insert(newImport);
+				sourcesToParse.push_back(newImport);
 			}
 		}
 	}
+
+	// Sources loaded via the read callback that are not imported anymore are dropped.
+	for (auto it = m_sources.begin(); it != m_sources.end();)
+		if (sourcesSeen.count(it->first))
+			++it;
+		else
+		{
+			retireAST(it->first);
+			it = m_sources.erase(it);
+		}
+
 	if (Error::containsOnlyWarnings(m_errorReporter.errors()))
 	{
 		m_stackState = ParsingSuccessful;
@@ -218,67 +420,116 @@ bool CompilerStack::parse()
 		return false;
 }
 
+void CompilerStack::retireAST(string const& _sourceName)
+{
+	Source& source = m_sources.at(_sourceName);
+	if (!source.ast)
+		return;
+	for (auto it = m_scopes.begin(); it != m_scopes.end();)
+		if (it->first && it->first->location().source && it->first->location().source->name() == _sourceName)
+			it = m_scopes.erase(it);
+		else
+			++it;
+	for (ASTPointer<ASTNode> const& node: source.ast->nodes())
+		if (ContractDefinition const* contract = dynamic_cast<ContractDefinition const*>(node.get()))
+			m_contracts.erase(contract->fullyQualifiedName());
+	m_retiredNodeCount += source.nodeIDCount;
+	m_retiredASTs.push_back(std::move(source.ast));
+}
+
 bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsingSuccessful || m_stackState >= AnalysisSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was successful."));
 	resolveImports();
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 
+	// The sources kept by updateSources() are not analysed again, the errors reported for
+	// them are repeated at the same position instead. Only checks that do not store anything
+	// in the AST and look at several sources at once run on all sources again.
 	bool noErrors = true;
 
 	try {
-		SyntaxChecker syntaxChecker(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (!syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
+		{
+			ProfilerPhase phase("analysis/SyntaxChecker");
+			SyntaxChecker syntaxChecker(m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				if (!analyseSource(*source, "analysis/SyntaxChecker", [&]() { return syntaxChecker.checkSyntax(*source->ast); }))
+					noErrors = false;
+		}
 
-		DocStringAnalyser docStringAnalyser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (!docStringAnalyser.analyseDocStrings(*source->ast))
-				noErrors = false;
+		{
+			ProfilerPhase phase("analysis/DocStringAnalyser");
+			DocStringAnalyser docStringAnalyser(m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				if (!analyseSource(*source, "analysis/DocStringAnalyser", [&]() { return docStringAnalyser.analyseDocStrings(*source->ast); }))
+					noErrors = false;
+		}
 
-		m_globalContext = make_shared<GlobalContext>();
-		NameAndTypeResolver resolver(m_globalContext->declarations(), m_scopes, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (!resolver.registerDeclarations(*source->ast))
-				return false;
+		// The global context is kept together with the analysed sources that refer to it.
+		if (m_globalContext)
+			m_globalContext->renewIDs();
+		else
+			m_globalContext = make_shared<GlobalContext>();
+		{
+			ProfilerPhase phase("analysis/NameAndTypeResolver");
+			NameAndTypeResolver resolver(m_globalContext->declarations(), m_scopes, m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				if (!analyseSource(*source, "analysis/NameAndTypeResolver/registerDeclarations", [&]() {
+					return resolver.registerDeclarations(*source->ast);
+				}))
+					return false;
+
+			map<string, SourceUnit const*> sourceUnitsByName;
+			for (auto& source: m_sources)
+				sourceUnitsByName[source.first] = source.second.ast.get();
+			for (Source const* source: m_sourceOrder)
+				if (!analyseSource(*source, "analysis/NameAndTypeResolver/performImports", [&]() {
+					return resolver.performImports(*source->ast, sourceUnitsByName);
+				}))
+					return false;
 
-		map<string, SourceUnit const*> sourceUnitsByName;
-		for (auto& source: m_sources)
-			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
-			if (!resolver.performImports(*source->ast, sourceUnitsByName))
-				return false;
-
-		// This is the main name and type resolution loop. Needs to be run for every contract, because
-		// the special variables "this" and "super" must be set appropriately.
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-				{
-					m_globalContext->setCurrentContract(*contract);
-					if (!resolver.updateDeclaration(*m_globalContext->currentThis())) return false;
-					if (!resolver.updateDeclaration(*m_globalContext->currentSuper())) return false;
-					if (!resolver.resolveNamesAndTypes(*contract)) return false;
-
-					// Note that we now reference contracts by their fully qualified names, and
-					// thus contracts can only conflict if declared in the same source file.  This
-					// already causes a double-declaration error elsewhere, so we do not report
-					// an error here and instead silently drop any additional contracts we find.
-					if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
-						m_contracts[contract->fullyQualifiedName()].contract = contract;
-				}
+			// This is the main name and type resolution loop. Needs to be run for every contract, because
+			// the special variables "this" and "super" must be set appropriately.
+			for (Source const* source: m_sourceOrder)
+				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+					{
+						m_globalContext->setCurrentContract(*contract);
+						if (!resolver.updateDeclaration(*m_globalContext->currentThis())) return false;
+						if (!resolver.updateDeclaration(*m_globalContext->currentSuper())) return false;
+						if (!analyseSource(*source, "analysis/NameAndTypeResolver/resolveNamesAndTypes:" + contract->name(), [&]() {
+							return resolver.resolveNamesAndTypes(*contract);
+						}))
+							return false;
+
+						// Note that we now reference contracts by their fully qualified names, and
+						// thus contracts can only conflict if declared in the same source file.  This
+						// already causes a double-declaration error elsewhere, so we do not report
+						// an error here and instead silently drop any additional contracts we find.
+						if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
+							m_contracts[contract->fullyQualifiedName()].contract = contract;
+					}
+		}
 
 		// Next, we check inheritance, overrides, function collisions and other things at
 		// contract or function level.
 		// This also calculates whether a contract is abstract, which is needed by the
 		// type checker.
-		ContractLevelChecker contractLevelChecker(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-					if (!contractLevelChecker.check(*contract))
-						noErrors = false;
+		{
+			ProfilerPhase phase("analysis/ContractLevelChecker");
+			ContractLevelChecker contractLevelChecker(m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				if (!analyseSource(*source, "analysis/ContractLevelChecker", [&]() {
+					bool success = true;
+					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+							if (!contractLevelChecker.check(*contract))
+								success = false;
+					return success;
+				}))
+					noErrors = false;
+		}
 
 		// New we run full type checks that go down to the expression level. This
 		// cannot be done earlier, because we need cross-contract types and information
@@ -287,19 +538,28 @@ bool CompilerStack::analyze()
 		//
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
-		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-					if (!typeChecker.checkTypeRequirements(*contract))
-						noErrors = false;
+		{
+			ProfilerPhase phase("analysis/TypeChecker");
+			TypeChecker typeChecker(m_evmVersion, m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				if (!analyseSource(*source, "analysis/TypeChecker", [&]() {
+					bool success = true;
+					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+							if (!typeChecker.checkTypeRequirements(*contract))
+								success = false;
+					return success;
+				}))
+					noErrors = false;
+		}
 
 		if (noErrors)
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
+			ProfilerPhase phase("analysis/PostTypeChecker");
 			PostTypeChecker postTypeChecker(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
-				if (!postTypeChecker.check(*source->ast))
+				if (!analyseSource(*source, "analysis/PostTypeChecker", [&]() { return postTypeChecker.check(*source->ast); }))
 					noErrors = false;
 		}
 
@@ -307,16 +567,17 @@ bool CompilerStack::analyze()
 		{
 			// Control flow graph generator and analyzer. It can check for issues such as
 			// variable is used before it is assigned to.
+			ProfilerPhase phase("analysis/ControlFlowAnalyzer");
 			CFG cfg(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
-				if (!cfg.constructFlow(*source->ast))
+				if (!analyseSource(*source, "analysis/ControlFlowAnalyzer/constructFlow", [&]() { return cfg.constructFlow(*source->ast); }))
 					noErrors = false;
 
 			if (noErrors)
 			{
 				ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter);
 				for (Source const* source: m_sourceOrder)
-					if (!controlFlowAnalyzer.analyze(*source->ast))
+					if (!analyseSource(*source, "analysis/ControlFlowAnalyzer", [&]() { return controlFlowAnalyzer.analyze(*source->ast); }))
 						noErrors = false;
 			}
 		}
@@ -324,15 +585,18 @@ bool CompilerStack::analyze()
 		if (noErrors)
 		{
 			// Checks for common mistakes. Only generates warnings.
+			ProfilerPhase phase("analysis/StaticAnalyzer");
 			StaticAnalyzer staticAnalyzer(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
-				if (!staticAnalyzer.analyze(*source->ast))
+				if (!analyseSource(*source, "analysis/StaticAnalyzer", [&]() { return staticAnalyzer.analyze(*source->ast); }))
 					noErrors = false;
 		}
 
 		if (noErrors)
 		{
 			// Check for state mutability in every function.
+			// The mutability of modifiers is inferred across sources, so this runs on all sources.
+			ProfilerPhase phase("analysis/ViewPureChecker");
 			vector<ASTPointer<ASTNode>> ast;
 			for (Source const* source: m_sourceOrder)
 				ast.push_back(source->ast);
@@ -343,10 +607,19 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
+			ProfilerPhase phase("analysis/SMTChecker");
 			SMTChecker smtChecker(m_errorReporter, m_smtlib2Responses);
 			for (Source const* source: m_sourceOrder)
-				smtChecker.analyze(*source->ast, source->scanner);
-			m_unhandledSMTLib2Queries += smtChecker.unhandledQueries();
+			{
+				analyseSource(*source, "analysis/SMTChecker", [&]() {
+					size_t const queryCount = smtChecker.unhandledQueries().size();
+					smtChecker.analyze(*source->ast, source->scanner);
+					vector<string> queries = smtChecker.unhandledQueries();
+					source->unhandledSMTLib2Queries.assign(queries.begin() + queryCount, queries.end());
+					return true;
+				});
+				m_unhandledSMTLib2Queries += source->unhandledSMTLib2Queries;
+			}
 		}
 	}
 	catch(FatalError const&)
@@ -358,6 +631,8 @@ bool CompilerStack::analyze()
 
 	if (noErrors)
 	{
+		for (auto& source: m_sources)
+			source.second.analysed = true;
 		m_stackState = AnalysisSuccessful;
 		return true;
 	}
@@ -365,6 +640,19 @@ bool CompilerStack::analyze()
 		return false;
 }
 
+bool CompilerStack::analyseSource(Source const& _source, string const& _phase, function<bool()> const& _analysis)
+{
+	if (_source.analysed)
+	{
+		m_errorReporter.replay(_source.errors.at(_phase));
+		return true;
+	}
+	size_t const errorCount = m_errorReporter.errors().size();
+	bool const success = _analysis();
+	_source.errors[_phase] = ErrorList(m_errorReporter.errors().begin() + errorCount, m_errorReporter.errors().end());
+	return success;
+}
+
 bool CompilerStack::parseAndAnalyze()
 {
 	return parse() && analyze();
@@ -381,25 +669,236 @@ bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) con
 bool CompilerStack::compile()
 {
 	if (m_stackState < AnalysisSuccessful)
-		if (!parseAndAnalyze())
+		if (!(m_stackState == ParsingSuccessful ? analyze() : parseAndAnalyze()))
 			return false;
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 
 	// Only compile contracts individually which have been requested.
-	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	vector<ContractDefinition const*> requestedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
-				{
-					compileContract(*contract, otherCompilers);
-					if (m_generateIR)
-						generateIR(*contract);
-				}
+					requestedContracts.push_back(contract);
+
+	compileContracts(requestedContracts);
+	if (m_generateIR)
+		for (auto const* contract: requestedContracts)
+			generateIR(*contract);
 	m_stackState = CompilationSuccessful;
+	if (m_compilationCache)
+		storeInCache();
 	this->link();
 	return true;
 }
 
+void CompilerStack::compileContracts(vector<ContractDefinition const*> const& _contracts)
+{
+	// Collect the contracts together with the contracts they create, dependencies first.
+	vector<ContractDefinition const*> contracts;
+	set<ContractDefinition const*> contractsSeen;
+	function<void(ContractDefinition const*)> collect = [&](ContractDefinition const* _contract)
+	{
+		if (contractsSeen.count(_contract) || !_contract->canBeDeployed())
+			return;
+		contractsSeen.insert(_contract);
+		for (auto const* dependency: _contract->annotation().contractDependencies)
+			collect(dependency);
+		contracts.push_back(_contract);
+	};
+	for (auto const* contract: _contracts)
+		collect(contract);
+
+	if (m_compilationCache)
+		contracts = loadFromCache(contracts);
+	set<ContractDefinition const*> contractsToCompile(contracts.begin(), contracts.end());
+
+	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	if (m_parallelism <= 1 || contracts.size() <= 1)
+	{
+		for (auto const* contract: contracts)
+			compileContract(*contract, otherCompilers, m_parallelism);
+		return;
+	}
+
+	// The annotations of the AST nodes are created on first access. Create all of them
+	// now, so that the workers only read the pointers to them.
+	SimpleASTVisitor annotationCreator(
+		[](ASTNode const& _node) { _node.annotation(); return true; },
+		[](ASTNode const&) {}
+	);
+	for (Source const* source: m_sourceOrder)
+		source->ast->accept(annotationCreator);
+	for (Declaration const* declaration: m_globalContext->declarations())
+		declaration->annotation();
+
+	// The metadata is generated from lazily filled caches in the AST, some of which
+	// are shared between contracts. Generate it upfront so that it does not have to be
+	// computed concurrently. The hashes of the sources are cached per source and are
+	// independent of each other, so they are computed concurrently first.
+	set<Source const*> referencedSources;
+	for (auto const* contract: contracts)
+	{
+		referencedSources.insert(&m_sources.at(contract->sourceUnit().annotation().path));
+		for (auto const* sourceUnit: contract->sourceUnit().referencedSourceUnits(true))
+			referencedSources.insert(&m_sources.at(sourceUnit->annotation().path));
+	}
+	if (referencedSources.size() >= m_parallelism)
+	{
+		ThreadPool pool(m_parallelism);
+		for (Source const* source: referencedSources)
+			pool.schedule([&, source]()
+			{
+				source->keccak256();
+				if (!m_metadataLiteralSources)
+					source->swarmHash();
+			});
+		pool.wait();
+	}
+	else
+		// There are fewer sources than jobs: Hash the sources one after the other,
+		// but split the swarm hash of large sources between all jobs.
+		for (Source const* source: referencedSources)
+		{
+			source->keccak256();
+			if (!m_metadataLiteralSources)
+				source->swarmHash(m_parallelism);
+		}
+	for (auto const* contract: contracts)
+		metadata(m_contracts.at(contract->fullyQualifiedName()));
+
+	// A contract can be compiled as soon as all contracts it creates have been compiled.
+	map<ContractDefinition const*, size_t> missingDependencies;
+	map<ContractDefinition const*, vector<ContractDefinition const*>> dependentContracts;
+	for (auto const* contract: contracts)
+	{
+		missingDependencies[contract] = 0;
+		for (auto const* dependency: contract->annotation().contractDependencies)
+			if (contractsToCompile.count(dependency))
+			{
+				++missingDependencies[contract];
+				dependentContracts[dependency].push_back(contract);
+			}
+	}
+
+	// Protects otherCompilers, missingDependencies and failures.
+	// The contracts already use all jobs, so they are optimised sequentially.
+	mutex schedulerMutex;
+	// Exceptions are collected per contract instead of being rethrown by the pool, so that
+	// the reported error does not depend on the order in which the workers finish.
+	map<ContractDefinition const*, exception_ptr> failures;
+	ThreadPool pool(m_parallelism);
+	function<void(ContractDefinition const*)> scheduleContract = [&](ContractDefinition const* _contract)
+	{
+		pool.schedule([&, _contract]()
+		{
+			TypeProvider::Scope typeProviderScope(*m_typeProvider);
+			map<ContractDefinition const*, shared_ptr<Compiler const>> compilers;
+			{
+				lock_guard<mutex> lock(schedulerMutex);
+				compilers = otherCompilers;
+			}
+			try
+			{
+				compileContract(*_contract, compilers, 1);
+			}
+			catch (...)
+			{
+				// Contracts that create this contract are not compiled at all.
+				lock_guard<mutex> lock(schedulerMutex);
+				failures[_contract] = current_exception();
+				return;
+			}
+
+			lock_guard<mutex> lock(schedulerMutex);
+			otherCompilers[_contract] = compilers.at(_contract);
+			for (auto const* dependent: dependentContracts[_contract])
+				if (--missingDependencies[dependent] == 0)
+					scheduleContract(dependent);
+		});
+	};
+	for (auto const* contract: contracts)
+		if (missingDependencies[contract] == 0)
+			scheduleContract(contract);
+	pool.wait();
+
+	// The contracts are ordered such that a contract comes after the contracts it creates,
+	// so this is the exception the sequential compilation would have thrown.
+	for (auto const* contract: contracts)
+		if (failures.count(contract))
+			rethrow_exception(failures.at(contract));
+}
+
+vector<ContractDefinition const*> CompilerStack::loadFromCache(vector<ContractDefinition const*> const& _contracts)
+{
+	solAssert(m_compilationCache, "");
+
+	map<ContractDefinition const*, CompilationCache::Entry> cachedContracts;
+	for (auto const* contract: _contracts)
+		if (auto entry = m_compilationCache->load(cacheKey(m_contracts.at(contract->fullyQualifiedName()))))
+			cachedContracts[contract] = std::move(*entry);
+
+	// Contracts come after the contracts they create, so one pass in reverse order is enough.
+	set<ContractDefinition const*> contractsToCompile;
+	for (auto const* contract: _contracts | boost::adaptors::reversed)
+		if (contractsToCompile.count(contract) || !cachedContracts.count(contract))
+		{
+			contractsToCompile.insert(contract);
+			for (auto const* dependency: contract->annotation().contractDependencies)
+				contractsToCompile.insert(dependency);
+		}
+
+	vector<ContractDefinition const*> remainingContracts;
+	for (auto const* contract: _contracts)
+	{
+		if (contractsToCompile.count(contract))
+		{
+			remainingContracts.push_back(contract);
+			continue;
+		}
+		Contract& cachedContract = m_contracts.at(contract->fullyQualifiedName());
+		CompilationCache::Entry& entry = cachedContracts.at(contract);
+		cachedContract.object = std::move(entry.object);
+		cachedContract.runtimeObject = std::move(entry.runtimeObject);
+		cachedContract.sourceMapping.reset(new string(std::move(entry.sourceMapping)));
+		cachedContract.runtimeSourceMapping.reset(new string(std::move(entry.runtimeSourceMapping)));
+		cachedContract.cachedAssembly.reset(new string(std::move(entry.assembly)));
+		cachedContract.cachedAssemblyJSON.reset(new Json::Value(std::move(entry.assemblyJSON)));
+	}
+	return remainingContracts;
+}
+
+void CompilerStack::storeInCache()
+{
+	solAssert(m_compilationCache, "");
+	solAssert(m_stackState == CompilationSuccessful, "");
+
+	set<string> const sourceNames = sourceNameSet();
+	for (auto const& contract: m_contracts)
+	{
+		shared_ptr<Compiler> const& compiler = contract.second.compiler;
+		if (!compiler)
+			continue;
+		CompilationCache::Entry entry;
+		entry.object = contract.second.object;
+		entry.runtimeObject = contract.second.runtimeObject;
+		entry.sourceMapping = *sourceMapping(contract.first);
+		entry.runtimeSourceMapping = *runtimeSourceMapping(contract.first);
+		entry.assembly = compiler->assemblyString(sourceNames);
+		entry.assemblyJSON = compiler->assemblyJSON();
+		m_compilationCache->store(cacheKey(contract.second), entry);
+	}
+	m_compilationCache->evict();
+}
+
+h256 CompilerStack::cacheKey(Contract const& _contract) const
+{
+	string key = VersionString + '\0' + metadata(_contract);
+	for (auto const& source: m_sources)
+		key += '\0' + source.first;
+	return dev::keccak256(key);
+}
+
 void CompilerStack::link()
 {
 	solAssert(m_stackState >= CompilationSuccessful, "");
@@ -536,27 +1035,31 @@ eth::LinkerObject const& CompilerStack::runtimeObject(string const& _contractNam
 }
 
 /// TODO: cache this string
-string CompilerStack::assemblyString(string const& _contractName, StringMap _sourceCodes) const
+string CompilerStack::assemblyString(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.compiler)
-		return currentContract.compiler->assemblyString(_sourceCodes);
+		return currentContract.compiler->assemblyString(sourceNameSet());
+	else if (currentContract.cachedAssembly)
+		return *currentContract.cachedAssembly;
 	else
 		return string();
 }
 
 /// TODO: cache the JSON
-Json::Value CompilerStack::assemblyJSON(string const& _contractName, StringMap _sourceCodes) const
+Json::Value CompilerStack::assemblyJSON(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.compiler)
-		return currentContract.compiler->assemblyJSON(_sourceCodes);
+		return currentContract.compiler->assemblyJSON();
+	else if (currentContract.cachedAssemblyJSON)
+		return *currentContract.cachedAssemblyJSON;
 	else
 		return Json::Value();
 }
@@ -569,6 +1072,14 @@ vector<string> CompilerStack::sourceNames() const
 	return names;
 }
 
+set<string> CompilerStack::sourceNameSet() const
+{
+	set<string> names;
+	for (auto const& s: m_sources)
+		names.insert(s.first);
+	return names;
+}
+
 map<string, unsigned> CompilerStack::sourceIndices() const
 {
 	map<string, unsigned> indices;
@@ -742,10 +1253,10 @@ h256 const& CompilerStack::Source::keccak256() const
 	return keccak256HashCached;
 }
 
-h256 const& CompilerStack::Source::swarmHash() const
+h256 const& CompilerStack::Source::swarmHash(unsigned _jobs) const
 {
 	if (swarmHashCached == h256{})
-		swarmHashCached = dev::swarmHash(scanner->source());
+		swarmHashCached = dev::swarmHash(scanner->source(), _jobs);
 	return swarmHashCached;
 }
 
@@ -872,7 +1383,8 @@ bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& featu
 
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
-	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
+	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers,
+	unsigned _jobs
 )
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
@@ -880,11 +1392,12 @@ void CompilerStack::compileContract(
 	if (_otherCompilers.count(&_contract) || !_contract.canBeDeployed())
 		return;
 	for (auto const* dependency: _contract.annotation().contractDependencies)
-		compileContract(*dependency, _otherCompilers);
+		compileContract(*dependency, _otherCompilers, _jobs);
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	ProfilerContext profilerContext(_contract.fullyQualifiedName());
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_optimiserSettings);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_optimiserSettings, _jobs);
 	compiledContract.compiler = compiler;
 
 	bytes cborEncodedMetadata = createCBORMetadata(
@@ -902,6 +1415,7 @@ void CompilerStack::compileContract(
 		solAssert(false, "Optimizer exception during compilation");
 	}
 
+	ProfilerPhase profilerPhase("evmasm/assemble");
 	try
 	{
 		// Assemble deployment (incl. runtime)  object.
@@ -939,7 +1453,9 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	for (auto const* dependency: _contract.annotation().contractDependencies)
 		generateIR(*dependency);
 
-	IRGenerator generator(m_evmVersion, m_optimiserSettings);
+	ProfilerContext profilerContext(_contract.fullyQualifiedName());
+	ProfilerPhase profilerPhase("codegen/IRGenerator");
+	IRGenerator generator(m_evmVersion, m_optimiserSettings, m_parallelism);
 	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract);
 }
 
@@ -1040,6 +1556,10 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 		{
 			details["yulDetails"] = Json::objectValue;
 			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
+			if (m_optimiserSettings.yulOptimiserSteps != yul::OptimiserSuite::DefaultSteps)
+				details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps;
+			if (m_optimiserSettings.optimizeFunctionsSeparately)
+				details["yulDetails"]["separateFunctions"] = true;
 		}
 
 		meta["settings"]["optimizer"]["details"] = std::move(details);
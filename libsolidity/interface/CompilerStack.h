@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 
@@ -32,6 +33,8 @@
 
 #include <libevmasm/LinkerObject.h>
 
+#include <libyul/YulString.h>
+
 #include <libdevcore/Common.h>
 #include <libdevcore/FixedHash.h>
 
@@ -70,6 +73,7 @@ class SourceUnit;
 class Compiler;
 class GlobalContext;
 class Natspec;
+class TypeProvider;
 class DeclarationContainer;
 
 /**
@@ -147,12 +151,36 @@ public:
 	/// Enable experimental generation of Yul IR code.
 	void enableIRGeneration(bool _enable = true) { m_generateIR = _enable; }
 
+	/// Sets the maximal number of contracts that are compiled concurrently.
+	/// Zero means one per hardware thread. Does not influence the output.
+	void setParallelism(unsigned _parallelism);
+
+	/// Sets the persistent cache for compiled contracts. Contracts found in the cache are not
+	/// compiled, so only their bytecode, source mappings and assembly are available (the
+	/// assembly is rendered with the sources of this compiler stack), but no gas estimates.
+	/// The default is to not use a cache.
+	void setCompilationCache(std::shared_ptr<CompilationCache> _cache) { m_compilationCache = std::move(_cache); }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
 
 	/// Sets the sources. Must be set before parsing.
-	void setSources(StringMap const& _sources);
+	/// The texts are moved into the compiler stack, so callers should move them in and read
+	/// them back via scanner() instead of keeping a copy.
+	void setSources(StringMap _sources);
+
+	/// Replaces the content of the given sources or adds new sources, keeping the other
+	/// sources and the settings. Can be called in any state after the sources were set.
+	/// If the sources did not change and were already parsed, all results are kept.
+	/// If the last analysis was successful, the ASTs and analysis results of the sources that
+	/// neither changed nor (transitively) import a changed source are kept, and only the other
+	/// sources are parsed and analysed again. Otherwise, all sources are parsed again.
+	/// In both cases, the result (including node IDs and errors) is the same as for a new
+	/// compilation, i.e. sources that were loaded via the read callback are read again.
+	/// Continue with analyze() or compile().
+	/// @returns false on error.
+	bool updateSources(StringMap _sources);
 
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
@@ -172,6 +200,7 @@ public:
 	bool parseAndAnalyze();
 
 	/// Compiles the source units that were previously added and parsed.
+	/// Parses and analyses the sources first if that did not happen yet.
 	/// @returns false on error.
 	bool compile();
 
@@ -232,15 +261,14 @@ public:
 	/// if the contract does not (yet) have bytecode.
 	std::string const* runtimeSourceMapping(std::string const& _contractName) const;
 
-	/// @return a verbose text representation of the assembly.
-	/// @arg _sourceCodes is the map of input files to source code strings
+	/// @return a verbose text representation of the assembly, which shows the start of the
+	/// source code each part of it was generated from.
 	/// Prerequisite: Successful compilation.
-	std::string assemblyString(std::string const& _contractName, StringMap _sourceCodes = StringMap()) const;
+	std::string assemblyString(std::string const& _contractName) const;
 
 	/// @returns a JSON representation of the assembly.
-	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
-	Json::Value assemblyJSON(std::string const& _contractName, StringMap _sourceCodes = StringMap()) const;
+	Json::Value assemblyJSON(std::string const& _contractName) const;
 
 	/// @returns a JSON representing the contract ABI.
 	/// Prerequisite: Successful call to parse or compile.
@@ -271,9 +299,24 @@ private:
 		std::shared_ptr<SourceUnit> ast;
 		h256 mutable keccak256HashCached;
 		h256 mutable swarmHashCached;
+		/// True if the source was not set, but loaded via the read callback during parsing.
+		bool loadedViaCallback = false;
+		/// The value of the node ID counter before parsing the source and the number of IDs
+		/// used while parsing it. Used to give the nodes of a kept AST the IDs of a new compilation.
+		size_t nodeIDOffset = 0;
+		size_t nodeIDCount = 0;
+		/// True if the source was analysed successfully. It is not parsed and analysed again
+		/// unless updateSources() discards the AST.
+		bool analysed = false;
+		/// The errors reported for the source per phase. Reported again instead of running the
+		/// phase if the source is kept.
+		std::map<std::string, langutil::ErrorList> mutable errors;
+		/// The SMTLib2 queries of the source that could not be answered.
+		std::vector<std::string> mutable unhandledSMTLib2Queries;
 		void reset() { *this = Source(); }
 		h256 const& keccak256() const;
-		h256 const& swarmHash() const;
+		/// Uses up to @a _jobs threads if the hash is not cached yet.
+		h256 const& swarmHash(unsigned _jobs = 1) const;
 	};
 
 	/// The state per contract. Filled gradually during compilation.
@@ -291,6 +334,9 @@ private:
 		mutable std::unique_ptr<Json::Value const> devDocumentation;
 		mutable std::unique_ptr<std::string const> sourceMapping;
 		mutable std::unique_ptr<std::string const> runtimeSourceMapping;
+		/// Assembly loaded from the compilation cache. Only used if there is no compiler.
+		std::unique_ptr<std::string const> cachedAssembly;
+		std::unique_ptr<Json::Value const> cachedAssemblyJSON;
 	};
 
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
@@ -300,15 +346,45 @@ private:
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 
+	/// Moves the AST of the source @a _sourceName to the retired ASTs and removes the
+	/// scopes and contracts that belong to it.
+	void retireAST(std::string const& _sourceName);
+
+	/// Runs @a _analysis on @a _source and records the errors it reports for @a _phase.
+	/// If the source was already analysed, reports the recorded errors again instead.
+	/// @returns the result of @a _analysis, or true if the source was already analysed.
+	bool analyseSource(Source const& _source, std::string const& _phase, std::function<bool()> const& _analysis);
+
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
+	/// Compiles the given contracts and the contracts they depend on.
+	/// Contracts that do not depend on each other are compiled concurrently
+	/// if the parallelism setting allows it.
+	void compileContracts(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// Loads the given contracts from the compilation cache where possible. Contracts that
+	/// are created by contracts which have to be compiled are compiled as well, because
+	/// their assembly is needed.
+	/// @returns the contracts that have to be compiled.
+	std::vector<ContractDefinition const*> loadFromCache(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// Stores all contracts compiled in this run in the compilation cache.
+	void storeInCache();
+
+	/// @returns the key of the contract in the compilation cache. This is the hash of its
+	/// metadata (which contains the hashes of all sources it depends on and all settings),
+	/// the full compiler version and the source names (the source mappings refer to their indices).
+	h256 cacheKey(Contract const& _contract) const;
+
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
+	/// @param _jobs number of jobs the optimiser of the contract may use.
 	void compileContract(
 		ContractDefinition const& _contract,
-		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers,
+		unsigned _jobs
 	);
 
 	/// Generate Yul IR for a single contract.
@@ -340,6 +416,10 @@ private:
 	/// @returns the computer source mapping string.
 	std::string computeSourceMapping(eth::AssemblyItems const& _items) const;
 
+	/// @returns the names of all sources. The code of these sources is shown in the assembly
+	/// output, the code generated by the compiler is not.
+	std::set<std::string> sourceNameSet() const;
+
 	/// @returns the contract ABI as a JSON object.
 	/// This will generate the JSON object and store it in the Contract object if it is not present yet.
 	Json::Value const& contractABI(Contract const&) const;
@@ -368,6 +448,8 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	std::set<std::string> m_requestedContractNames;
 	bool m_generateIR;
+	unsigned m_parallelism = 1;
+	std::shared_ptr<CompilationCache> m_compilationCache;
 	std::map<std::string, h160> m_libraries;
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
@@ -375,13 +457,23 @@ private:
 	std::map<std::string const, Source> m_sources;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<h256, std::string> m_smtlib2Responses;
+	/// Shares the elementary types between all ASTs of this stack. Activated for all threads
+	/// that parse, analyse or compile them.
+	std::shared_ptr<TypeProvider> m_typeProvider;
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
+	/// ASTs discarded by updateSources(). The types of the kept ASTs cache their members per
+	/// contract address, so the discarded contracts are only destroyed once the stack is reset.
+	std::vector<std::shared_ptr<SourceUnit>> m_retiredASTs;
+	/// Number of node IDs used by the retired ASTs.
+	size_t m_retiredNodeCount = 0;
 	/// This is updated during compilation.
 	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
 	std::map<std::string const, Contract> m_contracts;
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
+	/// Keeps the Yul strings of inline assembly blocks and generated code alive.
+	yul::YulStringRepository::Lease m_yulStringLease;
 	bool m_metadataLiteralSources = false;
 	State m_stackState = Empty;
 };
@@ -22,7 +22,10 @@
 
 #pragma once
 
+#include <libyul/optimiser/Suite.h>
+
 #include <cstddef>
+#include <string>
 
 namespace dev
 {
@@ -80,6 +83,8 @@ struct OptimiserSettings
 			runConstantOptimiser == _other.runConstantOptimiser &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
+			yulOptimiserSteps == _other.yulOptimiserSteps &&
+			optimizeFunctionsSeparately == _other.optimizeFunctionsSeparately &&
 			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
 	}
 
@@ -101,6 +106,11 @@ struct OptimiserSettings
 	bool optimizeStackAllocation = false;
 	/// Yul optimiser with default settings. Will only run on certain parts of the code for now.
 	bool runYulOptimiser = false;
+	/// Sequence of Yul optimiser steps, see yul::OptimiserSuite for the format.
+	std::string yulOptimiserSteps = yul::OptimiserSuite::DefaultSteps;
+	/// Apply the function-local steps of the Yul optimiser to each function separately, which
+	/// allows to optimise them concurrently. Can change the output.
+	bool optimizeFunctionsSeparately = false;
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
@@ -24,15 +24,21 @@
 
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libyul/AssemblyStack.h>
+#include <libyul/Exceptions.h>
+#include <libyul/optimiser/Suite.h>
+#include <libyul/YulString.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 #include <libevmasm/Instruction.h>
 #include <libdevcore/JSON.h>
 #include <libdevcore/Keccak256.h>
+#include <libdevcore/Profiler.h>
+#include <libdevcore/ThreadPool.h>
 
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/optional.hpp>
 #include <algorithm>
+#include <sstream>
 
 using namespace std;
 using namespace dev;
@@ -215,6 +221,30 @@ bool isBinaryRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if gas estimates were requested for any contract.
+bool isGasEstimateRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			if (isArtifactRequested(requests, "evm.gasEstimates", false))
+				return true;
+	return false;
+}
+
+/// @returns true if both lists of remappings are equal.
+bool equalRemappings(vector<CompilerStack::Remapping> const& _a, vector<CompilerStack::Remapping> const& _b)
+{
+	return _a.size() == _b.size() && equal(_a.begin(), _a.end(), _b.begin(), [](
+		CompilerStack::Remapping const& _x,
+		CompilerStack::Remapping const& _y
+	) {
+		return _x.context == _y.context && _x.prefix == _y.prefix && _x.target == _y.target;
+	});
+}
+
 /// @returns true if any Yul IR was requested. Note that as an exception, '*' does not
 /// yet match "ir" or "irOptimized"
 bool isIRRequested(Json::Value const& _outputSelection)
@@ -301,7 +331,7 @@ boost::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 boost::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "remappings"};
+	static set<string> keys{"evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "parallelism", "profiling", "remappings"};
 	return checkKeys(_input, keys, "settings");
 }
 
@@ -431,10 +461,31 @@ boost::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Valu
 			if (!settings.runYulOptimiser)
 				return formatFatalError("JSONError", "\"Providing yulDetails requires Yul optimizer to be enabled.");
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps", "separateFunctions"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "separateFunctions", settings.optimizeFunctionsSeparately))
+				return *error;
+			if (details["yulDetails"].isMember("optimizerSteps"))
+			{
+				Json::Value const& steps = details["yulDetails"]["optimizerSteps"];
+				if (!steps.isString())
+					return formatFatalError("JSONError", "\"settings.optimizer.details.yulDetails.optimizerSteps\" must be a string.");
+				try
+				{
+					yul::OptimiserSuite::validateSteps(steps.asString());
+				}
+				catch (yul::OptimizerException const& _exception)
+				{
+					return formatFatalError(
+						"JSONError",
+						"Invalid optimizer step sequence in \"settings.optimizer.details.yulDetails.optimizerSteps\": " +
+						string(_exception.what())
+					);
+				}
+				settings.yulOptimiserSteps = steps.asString();
+			}
 		}
 	}
 	return std::move(settings);
@@ -442,6 +493,83 @@ boost::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Valu
 
 }
 
+/**
+ * Collects the members of the output in a JSON value or writes them to a stream.
+ *
+ * When writing to a stream, added members are kept in serialized form until flush() is
+ * called. Members added after that have to come after the flushed ones in the output.
+ */
+class StandardCompiler::Output
+{
+public:
+	/// Builds a JSON value.
+	Output() = default;
+	/// Writes the output to @a _stream.
+	explicit Output(ostream& _stream): m_writer(new JsonStreamWriter(_stream)) {}
+
+	/// Adds @a _value at @a _path.
+	void add(vector<string> const& _path, Json::Value _value)
+	{
+		if (m_writer)
+			m_pending[_path] = jsonCompactPrint(_value);
+		else
+		{
+			Json::Value* member = &m_value;
+			for (string const& key: _path)
+				member = &(*member)[key];
+			*member = std::move(_value);
+		}
+	}
+	/// Adds the JSON representation of the AST @a _node at @a _path. When writing to a stream,
+	/// it is serialized directly without creating a JSON value for the whole tree.
+	void addAST(vector<string> const& _path, ASTJsonConverter&& _converter, ASTNode const& _node)
+	{
+		if (m_writer)
+			m_pending[_path] = _converter.toCompactJson(_node);
+		else
+			add(_path, _converter.toJson(_node));
+	}
+	/// Writes all pending members to the stream.
+	void flush()
+	{
+		if (!m_writer)
+			return;
+		for (auto const& member: m_pending)
+			m_writer->writeSerialized(member.first, member.second);
+		m_pending.clear();
+	}
+	/// Replaces the output by @a _output. Members that have already been written to the
+	/// stream are kept and members of @a _output that cannot follow them are dropped.
+	void replace(Json::Value _output)
+	{
+		if (!m_writer)
+		{
+			m_value = std::move(_output);
+			return;
+		}
+		m_pending.clear();
+		for (string const& name: _output.getMemberNames())
+			if (m_writer->canWrite({name}))
+				add({name}, std::move(_output[name]));
+		flush();
+	}
+	/// Writes the remaining members and closes the output, unless it is already closed.
+	void finish()
+	{
+		flush();
+		if (m_writer && !m_writer->finished())
+			m_writer->finish();
+	}
+
+	/// @returns the collected output if not writing to a stream.
+	Json::Value& value() { return m_value; }
+
+private:
+	unique_ptr<JsonStreamWriter> m_writer;
+	map<vector<string>, string> m_pending;
+	Json::Value m_value = Json::objectValue;
+};
+
 boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseInput(Json::Value const& _input)
 {
 	InputsAndSettings ret;
@@ -586,6 +714,20 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 		ret.evmVersion = *version;
 	}
 
+	if (settings.isMember("parallelism"))
+	{
+		if (!settings["parallelism"].isUInt())
+			return formatFatalError("JSONError", "\"settings.parallelism\" must be an unsigned number.");
+		ret.parallelism = settings["parallelism"].asUInt();
+	}
+
+	if (settings.isMember("profiling"))
+	{
+		if (!settings["profiling"].isBool())
+			return formatFatalError("JSONError", "\"settings.profiling\" must be a Boolean.");
+		ret.profiling = settings["profiling"].asBool();
+	}
+
 	if (settings.isMember("remappings") && !settings["remappings"].isArray())
 		return formatFatalError("JSONError", "\"settings.remappings\" must be an array of strings.");
 
@@ -666,35 +808,70 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 	return std::move(ret);
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+void StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, Output& _output)
 {
-	CompilerStack compilerStack(m_readFile);
-
-	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	compilerStack.setSources(sourceList);
-	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
-		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
-	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
-	compilerStack.setRemappings(_inputsAndSettings.remappings);
-	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
-	compilerStack.setLibraries(_inputsAndSettings.libraries);
-	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
-	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
+	boost::optional<StringMap> sourceUpdates = retainedCompilerStackUpdates(_inputsAndSettings);
+	bool const reuseCompilerStack = !!sourceUpdates;
+	unique_ptr<CompilerStack> ownedCompilerStack;
+	if (reuseCompilerStack)
+		ownedCompilerStack = std::move(m_retainedCompilerStack);
+	else
+	{
+		m_retainedCompilerStack.reset();
+		// Reclaim the Yul strings of earlier compilations, unless somebody still uses them.
+		yul::YulStringRepository::instance().reset();
+		ownedCompilerStack.reset(new CompilerStack(m_readFile));
+	}
+	CompilerStack& compilerStack = *ownedCompilerStack;
+
+	set<string> inputSourceNames;
+	for (auto const& source: _inputsAndSettings.sources)
+		inputSourceNames.insert(source.first);
 
 	bool const irRequested = isIRRequested(_inputsAndSettings.outputSelection);
+	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
+	bool compilerStackIsValid = false;
 
-	compilerStack.enableIRGeneration(irRequested);
+	if (!reuseCompilerStack)
+	{
+		compilerStack.setSources(std::move(_inputsAndSettings.sources));
+		for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
+			compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
+		compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
+		compilerStack.setRemappings(_inputsAndSettings.remappings);
+		compilerStack.setOptimiserSettings(_inputsAndSettings.optimiserSettings);
+		if (!isGasEstimateRequested(_inputsAndSettings.outputSelection))
+			compilerStack.setCompilationCache(m_compilationCache);
+		compilerStack.setLibraries(_inputsAndSettings.libraries);
+		compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
+		compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
+		compilerStack.enableIRGeneration(irRequested);
+	}
+	// Does not influence the output, so it can also change for a retained compiler stack.
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
+	// The compiler stack keeps the only copy of the sources, the other inputs are retained
+	// together with it.
+	_inputsAndSettings.sources.clear();
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
-	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
-
 	try
 	{
-		if (binariesRequested)
-			compilerStack.compile();
-		else
-			compilerStack.parseAndAnalyze();
+		if (!reuseCompilerStack)
+		{
+			if (binariesRequested)
+				compilerStack.compile();
+			else
+				compilerStack.parseAndAnalyze();
+		}
+		else if (!sourceUpdates->empty() && compilerStack.updateSources(std::move(*sourceUpdates)))
+		{
+			if (binariesRequested)
+				compilerStack.compile();
+			else
+				compilerStack.analyze();
+		}
+		compilerStackIsValid = true;
 
 		for (auto const& error: compilerStack.errors())
 		{
@@ -784,39 +961,37 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 
 	/// Inconsistent state - stop here to receive error reports from users
 	if (((binariesRequested && !compilationSuccess) || !analysisSuccess) && errors.empty())
-		return formatFatalError("InternalCompilerError", "No error reported, but compilation failed.");
-
-	Json::Value output = Json::objectValue;
-
-	if (errors.size() > 0)
-		output["errors"] = std::move(errors);
+	{
+		_output.replace(formatFatalError("InternalCompilerError", "No error reported, but compilation failed."));
+		return;
+	}
 
+	// The members are added in the order of the output, so that the artifacts of each
+	// contract can be written and freed before the next one is produced.
 	if (!compilerStack.unhandledSMTLib2Queries().empty())
+	{
+		Json::Value queries = Json::objectValue;
 		for (string const& query: compilerStack.unhandledSMTLib2Queries())
-			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + keccak256(query).hex()] = query;
+			queries["0x" + keccak256(query).hex()] = query;
+		_output.add({"auxiliaryInputRequested", "smtlib2queries"}, std::move(queries));
+	}
 
 	bool const wildcardMatchesIR = false;
 
-	output["sources"] = Json::objectValue;
-	unsigned sourceIndex = 0;
-	for (string const& sourceName: analysisSuccess ? compilerStack.sourceNames() : vector<string>())
-	{
-		Json::Value sourceResult = Json::objectValue;
-		sourceResult["id"] = sourceIndex++;
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesIR))
-			sourceResult["ast"] = ASTJsonConverter(false, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "legacyAST", wildcardMatchesIR))
-			sourceResult["legacyAST"] = ASTJsonConverter(true, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-		output["sources"][sourceName] = sourceResult;
-	}
-
-	Json::Value contractsOutput = Json::objectValue;
+	// Contracts are grouped by their source unit in the output.
+	map<pair<string, string>, string> contracts;
 	for (string const& contractName: analysisSuccess ? compilerStack.contractNames() : vector<string>())
 	{
 		size_t colon = contractName.rfind(':');
 		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
+		contracts[make_pair(contractName.substr(0, colon), contractName.substr(colon + 1))] = contractName;
+	}
+
+	for (auto const& contract: contracts)
+	{
+		string const& file = contract.first.first;
+		string const& name = contract.first.second;
+		string const& contractName = contract.second;
 
 		// ABI, documentation and metadata
 		Json::Value contractData(Json::objectValue);
@@ -838,9 +1013,9 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		// EVM
 		Json::Value evmData(Json::objectValue);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesIR))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
+			evmData["assembly"] = compilerStack.assemblyString(contractName);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesIR))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName, sourceList);
+			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesIR))
 			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesIR))
@@ -871,22 +1046,105 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			);
 
 		if (!evmData.empty())
-			contractData["evm"] = evmData;
+			contractData["evm"] = std::move(evmData);
 
 		if (!contractData.empty())
 		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			_output.add({"contracts", file, name}, std::move(contractData));
+			_output.flush();
 		}
 	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
 
-	return output;
+	// The remaining members are written together at the end. This way, internal errors
+	// while producing the ASTs can still be reported in "errors".
+	if (errors.size() > 0)
+		_output.add({"errors"}, std::move(errors));
+
+	vector<string> const sourceNames = analysisSuccess ? compilerStack.sourceNames() : vector<string>();
+	if (sourceNames.empty())
+		_output.add({"sources"}, Json::objectValue);
+	unsigned sourceIndex = 0;
+	for (string const& sourceName: sourceNames)
+	{
+		_output.add({"sources", sourceName, "id"}, sourceIndex++);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesIR))
+			_output.addAST(
+				{"sources", sourceName, "ast"},
+				ASTJsonConverter(false, compilerStack.sourceIndices()),
+				compilerStack.ast(sourceName)
+			);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "legacyAST", wildcardMatchesIR))
+			_output.addAST(
+				{"sources", sourceName, "legacyAST"},
+				ASTJsonConverter(true, compilerStack.sourceIndices()),
+				compilerStack.ast(sourceName)
+			);
+	}
+
+	if (m_retainCompilerStack && compilerStackIsValid)
+	{
+		m_retainedCompilerStack = std::move(ownedCompilerStack);
+		m_retainedInputsAndSettings = std::move(_inputsAndSettings);
+		m_retainedSourceNames = std::move(inputSourceNames);
+	}
 }
 
 
+boost::optional<StringMap> StandardCompiler::retainedCompilerStackUpdates(InputsAndSettings const& _inputsAndSettings)
+{
+	if (!m_retainedCompilerStack)
+		return {};
+
+	InputsAndSettings const& retained = m_retainedInputsAndSettings;
+	if (
+		_inputsAndSettings.smtLib2Responses != retained.smtLib2Responses ||
+		!(_inputsAndSettings.evmVersion == retained.evmVersion) ||
+		!equalRemappings(_inputsAndSettings.remappings, retained.remappings) ||
+		!(_inputsAndSettings.optimiserSettings == retained.optimiserSettings) ||
+		_inputsAndSettings.libraries != retained.libraries ||
+		_inputsAndSettings.metadataLiteralSources != retained.metadataLiteralSources
+	)
+		return {};
+
+	Json::Value const& selection = _inputsAndSettings.outputSelection;
+	if (
+		requestedContractNames(selection) != requestedContractNames(retained.outputSelection) ||
+		isIRRequested(selection) != isIRRequested(retained.outputSelection) ||
+		isBinaryRequested(selection) != isBinaryRequested(retained.outputSelection) ||
+		isGasEstimateRequested(selection) != isGasEstimateRequested(retained.outputSelection)
+	)
+		return {};
+
+	// Sources cannot be removed from a compiler stack.
+	for (string const& sourceName: m_retainedSourceNames)
+		if (!_inputsAndSettings.sources.count(sourceName))
+			return {};
+
+	StringMap updates;
+	for (auto const& source: _inputsAndSettings.sources)
+		if (
+			!m_retainedSourceNames.count(source.first) ||
+			m_retainedCompilerStack->scanner(source.first).source() != source.second
+		)
+			updates[source.first] = source.second;
+	if (!updates.empty())
+		// Updating the sources reads the sources loaded via the callback again.
+		return updates;
+
+	// Sources loaded via the callback are not part of the input, so they have to be read again.
+	for (string const& sourceName: m_retainedCompilerStack->sourceNames())
+		if (!_inputsAndSettings.sources.count(sourceName))
+		{
+			if (!m_readFile)
+				return {};
+			ReadCallback::Result result = m_readFile(sourceName);
+			if (!result.success || result.responseOrErrorMessage != m_retainedCompilerStack->scanner(sourceName).source())
+				return {};
+		}
+
+	return updates;
+}
+
 Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 {
 	if (_inputsAndSettings.sources.size() != 1)
@@ -903,7 +1161,8 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 	AssemblyStack stack(
 		_inputsAndSettings.evmVersion,
 		AssemblyStack::Language::StrictAssembly,
-		_inputsAndSettings.optimiserSettings
+		_inputsAndSettings.optimiserSettings,
+		_inputsAndSettings.parallelism == 0 ? ThreadPool::hardwareConcurrency() : _inputsAndSettings.parallelism
 	);
 	string const& sourceName = _inputsAndSettings.sources.begin()->first;
 	string const& sourceContents = _inputsAndSettings.sources.begin()->second;
@@ -963,63 +1222,111 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 }
 
 
+void StandardCompiler::setRetainCompilerStack(bool _retain)
+{
+	m_retainCompilerStack = _retain;
+	if (!_retain)
+		m_retainedCompilerStack.reset();
+}
+
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
+	Output output;
+	compile(_input, output);
+	return std::move(output.value());
+}
+
+string StandardCompiler::compile(string const& _input) noexcept
+{
+	ostringstream output;
+	compile(_input, output);
+	return output.str();
+}
+
+void StandardCompiler::compile(string const& _input, ostream& _output) noexcept
+{
+	Json::Value input;
+	string errors;
 	try
 	{
-		auto parsed = parseInput(_input);
-		if (parsed.type() == typeid(Json::Value))
-			return boost::get<Json::Value>(std::move(parsed));
-		InputsAndSettings settings = boost::get<InputsAndSettings>(std::move(parsed));
-		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
-		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
-		else
-			return formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language.");
-	}
-	catch (Json::LogicError const& _exception)
-	{
-		return formatFatalError("InternalCompilerError", string("JSON logic exception: ") + _exception.what());
+		if (!jsonParseStrict(_input, input, &errors))
+		{
+			_output << jsonCompactPrint(formatFatalError("JSONError", errors));
+			return;
+		}
 	}
-	catch (Json::RuntimeError const& _exception)
+	catch (...)
 	{
-		return formatFatalError("InternalCompilerError", string("JSON runtime exception: ") + _exception.what());
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		return;
 	}
-	catch (Exception const& _exception)
+
+	Output output(_output);
+	try
 	{
-		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception));
+		compile(input, output);
+		output.finish();
 	}
 	catch (...)
 	{
-		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile");
+		// Complete the document that has already been started instead of starting another one.
+		try
+		{
+			_output.clear();
+			output.replace(formatFatalError("JSONError", "Error writing output JSON."));
+			output.finish();
+		}
+		catch (...)
+		{
+		}
 	}
 }
 
-string StandardCompiler::compile(string const& _input) noexcept
+void StandardCompiler::compile(Json::Value const& _input, Output& _output)
 {
-	Json::Value input;
-	string errors;
 	try
 	{
-		if (!jsonParseStrict(_input, input, &errors))
-			return jsonCompactPrint(formatFatalError("JSONError", errors));
+		auto parsed = parseInput(_input);
+		if (parsed.type() == typeid(Json::Value))
+		{
+			_output.replace(boost::get<Json::Value>(std::move(parsed)));
+			return;
+		}
+		InputsAndSettings settings = boost::get<InputsAndSettings>(std::move(parsed));
+		if (settings.language != "Solidity" && settings.language != "Yul")
+		{
+			_output.replace(formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language."));
+			return;
+		}
+
+		// Only one compilation per process can be profiled at a time.
+		Profiler profiler;
+		if (settings.profiling)
+			profiler.activate();
+		if (settings.language == "Solidity")
+			compileSolidity(std::move(settings), _output);
+		else
+			_output.replace(compileYul(std::move(settings)));
+		if (Profiler::active() == &profiler)
+		{
+			profiler.deactivate();
+			_output.add({"profiling"}, profiler.summary());
+		}
 	}
-	catch (...)
+	catch (Json::LogicError const& _exception)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		_output.replace(formatFatalError("InternalCompilerError", string("JSON logic exception: ") + _exception.what()));
 	}
-
-	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
-	// cout << "Output: " << output.toStyledString() << endl;
-
-	try
+	catch (Json::RuntimeError const& _exception)
+	{
+		_output.replace(formatFatalError("InternalCompilerError", string("JSON runtime exception: ") + _exception.what()));
+	}
+	catch (Exception const& _exception)
 	{
-		return jsonCompactPrint(output);
+		_output.replace(formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception)));
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		_output.replace(formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile"));
 	}
 }
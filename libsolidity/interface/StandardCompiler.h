@@ -27,6 +27,9 @@
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
 
+#include <ostream>
+#include <set>
+
 namespace dev
 {
 
@@ -54,8 +57,29 @@ public:
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Same as above, but writes the output to @a _output while it is produced, so that the
+	/// artifacts of each contract are only kept in memory until they are written.
+	/// The output is the same, except if an internal error occurs after some contracts have
+	/// been written: They are kept in the output and followed by the error.
+	void compile(std::string const& _input, std::ostream& _output) noexcept;
+
+	/// Sets the persistent cache used for all following compilations. It is not used
+	/// for inputs that request gas estimates, since they are not stored in the cache.
+	void setCompilationCache(std::shared_ptr<CompilationCache> _cache) { m_compilationCache = std::move(_cache); }
+
+	/// If enabled, the compiler stack of the last Solidity compilation is kept and reused
+	/// by the next compilation if all settings except the requested outputs and the parallelism
+	/// are unchanged. Changed sources are passed to CompilerStack::updateSources(), which only
+	/// parses and analyses them and the sources importing them again. If no source changed
+	/// (including those read via the callback), the results are reused as they are.
+	/// Disabled by default.
+	void setRetainCompilerStack(bool _retain);
 
 private:
+	/// Receives the members of the output, either to build a JSON value or to write them
+	/// to a stream. Defined in StandardCompiler.cpp.
+	class Output;
+
 	struct InputsAndSettings
 	{
 		std::string language;
@@ -65,6 +89,8 @@ private:
 		langutil::EVMVersion evmVersion;
 		std::vector<CompilerStack::Remapping> remappings;
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
+		unsigned parallelism = 1;
+		bool profiling = false;
 		std::map<std::string, h160> libraries;
 		bool metadataLiteralSources = false;
 		Json::Value outputSelection;
@@ -74,10 +100,26 @@ private:
 	/// it in condensed form or an error as a json object.
 	boost::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Performs the compilation and adds the results to @a _output.
+	void compile(Json::Value const& _input, Output& _output);
+	void compileSolidity(InputsAndSettings _inputsAndSettings, Output& _output);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
+	/// @returns the sources that have to be updated in the retained compiler stack so that
+	/// it produces the same results as a new one would for @a _inputsAndSettings, or nothing
+	/// if it cannot be reused.
+	boost::optional<StringMap> retainedCompilerStackUpdates(InputsAndSettings const& _inputsAndSettings);
+
 	ReadCallback::Callback m_readFile;
+	std::shared_ptr<CompilationCache> m_compilationCache;
+
+	bool m_retainCompilerStack = false;
+	/// The compiler stack of the last compilation and the inputs it was created from.
+	/// The sources are only kept by the compiler stack.
+	std::unique_ptr<CompilerStack> m_retainedCompilerStack;
+	InputsAndSettings m_retainedInputsAndSettings;
+	/// The names of the sources in the input of the last compilation.
+	std::set<std::string> m_retainedSourceNames;
 };
 
 }
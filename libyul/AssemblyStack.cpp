@@ -145,7 +145,11 @@ void AssemblyStack::optimize(Object& _object)
 		languageToDialect(m_language, m_evmVersion),
 		*_object.code,
 		*_object.analysisInfo,
-		m_optimiserSettings.optimizeStackAllocation
+		m_optimiserSettings.optimizeStackAllocation,
+		{},
+		m_optimiserSettings.yulOptimiserSteps,
+		m_optimiserSettings.optimizeFunctionsSeparately,
+		m_parallelism
 	);
 }
 
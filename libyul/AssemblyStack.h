@@ -26,6 +26,7 @@
 
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/YulString.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
@@ -63,10 +64,18 @@ public:
 	AssemblyStack():
 		AssemblyStack(langutil::EVMVersion{}, Language::Assembly, dev::solidity::OptimiserSettings::none())
 	{}
-	AssemblyStack(langutil::EVMVersion _evmVersion, Language _language, dev::solidity::OptimiserSettings _optimiserSettings):
+	/// @param _parallelism maximal number of functions optimised concurrently if the settings
+	/// request to optimise functions separately.
+	AssemblyStack(
+		langutil::EVMVersion _evmVersion,
+		Language _language,
+		dev::solidity::OptimiserSettings _optimiserSettings,
+		unsigned _parallelism = 1
+	):
 		m_language(_language),
 		m_evmVersion(_evmVersion),
 		m_optimiserSettings(std::move(_optimiserSettings)),
+		m_parallelism(_parallelism),
 		m_errorReporter(m_errors)
 	{}
 
@@ -104,6 +113,7 @@ private:
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	dev::solidity::OptimiserSettings m_optimiserSettings;
+	unsigned m_parallelism = 1;
 
 	std::shared_ptr<langutil::Scanner> m_scanner;
 
@@ -111,6 +121,8 @@ private:
 	std::shared_ptr<yul::Object> m_parserResult;
 	langutil::ErrorList m_errors;
 	langutil::ErrorReporter m_errorReporter;
+	/// Keeps the Yul strings of the parsed objects alive.
+	YulStringRepository::Lease m_yulStringLease;
 };
 
 }
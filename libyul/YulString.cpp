@@ -0,0 +1,109 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * String abstraction that avoids copies.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+#include <vector>
+
+using namespace std;
+using namespace yul;
+
+YulStringRepository::YulStringRepository()
+{
+	for (auto& chunk: m_chunks)
+		chunk.store(nullptr, memory_order_relaxed);
+	// The empty string has ID zero, the others are used by function-local statics.
+	for (string const& predefined: {string(), string("0"), string("true"), string("false")})
+	{
+		uint64_t h = hash(predefined);
+		shard(h).hashToID.emplace(h, addString(predefined));
+	}
+	m_predefinedStrings = m_nextID;
+}
+
+YulStringRepository::~YulStringRepository()
+{
+	for (auto& chunk: m_chunks)
+		delete chunk.load(memory_order_relaxed);
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(string const& _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+	uint64_t h = hash(_string);
+	Shard& stringShard = shard(h);
+	lock_guard<mutex> lock(stringShard.mutex);
+	auto range = stringShard.hashToID.equal_range(h);
+	for (auto it = range.first; it != range.second; ++it)
+		if (idToString(it->second) == _string)
+			return Handle{it->second, h};
+	size_t id = addString(_string);
+	stringShard.hashToID.emplace_hint(range.second, make_pair(h, id));
+	return Handle{id, h};
+}
+
+bool YulStringRepository::reset()
+{
+	// Lock all shards, so that no strings are added in between. The shards have to be
+	// locked before the chunks, as in stringToHandle().
+	vector<unique_lock<mutex>> shardLocks;
+	for (auto& stringShard: m_shards)
+		shardLocks.emplace_back(stringShard.mutex);
+	lock_guard<mutex> chunkLock(m_chunkMutex);
+	if (m_leases > 0)
+		return false;
+
+	for (size_t id = m_predefinedStrings; id < m_nextID; ++id)
+		m_chunks[id / ChunkSize].load(memory_order_relaxed)->at(id % ChunkSize).reset();
+	for (size_t chunk = (m_predefinedStrings + ChunkSize - 1) / ChunkSize; chunk < m_chunks.size(); ++chunk)
+		delete m_chunks[chunk].exchange(nullptr, memory_order_relaxed);
+	for (auto& stringShard: m_shards)
+		for (auto it = stringShard.hashToID.begin(); it != stringShard.hashToID.end();)
+			if (it->second >= m_predefinedStrings)
+				it = stringShard.hashToID.erase(it);
+			else
+				++it;
+	m_nextID = m_predefinedStrings;
+	return true;
+}
+
+size_t YulStringRepository::addString(string const& _string)
+{
+	size_t id = m_nextID++;
+	size_t chunkIndex = id / ChunkSize;
+	assertThrow(chunkIndex < m_chunks.size(), YulException, "Too many distinct strings.");
+	Chunk* chunk = m_chunks[chunkIndex].load(memory_order_acquire);
+	if (!chunk)
+	{
+		lock_guard<mutex> lock(m_chunkMutex);
+		chunk = m_chunks[chunkIndex].load(memory_order_relaxed);
+		if (!chunk)
+		{
+			chunk = new Chunk();
+			m_chunks[chunkIndex].store(chunk, memory_order_release);
+		}
+	}
+	// Nobody else can access this entry before the ID is handed out.
+	chunk->at(id % ChunkSize).reset(new string(_string));
+	return id;
+}
@@ -22,10 +22,13 @@
 
 #include <boost/noncopyable.hpp>
 
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <vector>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace yul
 {
@@ -34,6 +37,8 @@ namespace yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+/// The repository can be used from multiple threads at the same time: Lookups by string
+/// lock one of several shards selected by the hash, lookups by ID do not lock at all.
 class YulStringRepository: boost::noncopyable
 {
 public:
@@ -43,28 +48,41 @@ public:
 		std::uint64_t hash;
 	};
 
-	YulStringRepository() = default;
+	/// Marks the strings as being in use: reset() does not reclaim anything while
+	/// at least one lease exists. Everything that keeps YulStrings beyond a single
+	/// function call (like a compiler stack) should hold a lease.
+	class Lease
+	{
+	public:
+		Lease() { ++instance().m_leases; }
+		Lease(Lease const&): Lease() {}
+		Lease& operator=(Lease const&) { return *this; }
+		~Lease() { --instance().m_leases; }
+	};
+
+	YulStringRepository();
+	~YulStringRepository();
 
 	static YulStringRepository& instance()
 	{
 		static YulStringRepository inst;
 		return inst;
 	}
-	Handle stringToHandle(std::string const& _string)
+	Handle stringToHandle(std::string const& _string);
+	std::string const& idToString(size_t _id) const
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-		return Handle{id, h};
+		return *m_chunks[_id / ChunkSize].load(std::memory_order_acquire)->at(_id % ChunkSize);
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
+
+	/// Frees all strings except for a few predefined ones (the empty string, "0", "true"
+	/// and "false"), which can be kept in static variables.
+	/// Does nothing if a lease is held. Otherwise, the caller has to ensure that no other
+	/// YulStrings are in use anymore, since their IDs will be reused.
+	/// @returns true if the strings were freed.
+	bool reset();
+
+	/// @returns the number of strings in the repository.
+	size_t size() const { return m_nextID; }
 
 	static std::uint64_t hash(std::string const& v)
 	{
@@ -81,8 +99,31 @@ public:
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
 
 private:
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	static size_t constexpr ChunkSize = 4096;
+	static size_t constexpr MaxChunks = 16384;
+	using Chunk = std::array<std::unique_ptr<std::string const>, ChunkSize>;
+
+	struct Shard
+	{
+		std::mutex mutex;
+		std::unordered_multimap<std::uint64_t, size_t> hashToID;
+	};
+
+	Shard& shard(std::uint64_t _hash) { return m_shards[_hash % m_shards.size()]; }
+	/// Stores @a _string under a new ID and @returns the ID. Has to be called with the lock
+	/// of the shard held that the string belongs to.
+	size_t addString(std::string const& _string);
+
+	std::array<Shard, 16> m_shards;
+	/// Protects the allocation of new chunks.
+	std::mutex m_chunkMutex;
+	/// Strings by ID. Chunks are only allocated and never moved while strings are in use,
+	/// so reading from them does not require a lock.
+	std::array<std::atomic<Chunk*>, MaxChunks> m_chunks;
+	std::atomic<size_t> m_nextID{0};
+	/// Number of predefined strings, which are never freed.
+	size_t m_predefinedStrings = 0;
+	std::atomic<size_t> m_leases{0};
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -117,6 +158,10 @@ public:
 	bool operator!=(YulString const& _other) const { return m_handle.id != _other.m_handle.id; }
 
 	bool empty() const { return m_handle.id == 0; }
+	/// @returns the ID of the string, which depends on the order in which strings were created.
+	size_t id() const { return m_handle.id; }
+	/// @returns the deterministic hash of the string.
+	std::uint64_t hash() const { return m_handle.hash; }
 	std::string const& str() const
 	{
 		return YulStringRepository::instance().idToString(m_handle.id);
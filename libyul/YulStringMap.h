@@ -0,0 +1,167 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Hash map keyed by YulStrings.
+ */
+
+#pragma once
+
+#include <libyul/YulString.h>
+
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace yul
+{
+
+/**
+ * Open addressing hash map from YulStrings to values, hashed by the string ID.
+ *
+ * Lookups do not compare strings and do not follow pointers, which makes this much
+ * faster than a std::map for the per-variable bookkeeping of optimiser steps.
+ * Since IDs depend on the order in which strings were created, there is no iteration:
+ * Use a std::map if the output depends on the order of the elements.
+ */
+template <class T>
+class YulStringMap
+{
+public:
+	YulStringMap() = default;
+	explicit YulStringMap(std::map<YulString, T> const& _map)
+	{
+		for (auto const& element: _map)
+			(*this)[element.first] = element.second;
+	}
+
+	/// @returns the value for @a _key, default-constructs it if not present.
+	T& operator[](YulString _key)
+	{
+		if ((m_size + 1) * 4 > m_slots.size() * 3)
+			grow();
+		size_t index = slotIndex(_key);
+		Slot& slot = m_slots[index];
+		if (!slot.used)
+		{
+			slot.used = true;
+			slot.key = _key;
+			++m_size;
+		}
+		return slot.value;
+	}
+	/// @returns the value for @a _key, throws std::out_of_range if not present.
+	T const& at(YulString _key) const
+	{
+		if (T const* value = find(_key))
+			return *value;
+		throw std::out_of_range("Key not in map.");
+	}
+	/// @returns a pointer to the value for @a _key or nullptr if not present.
+	T const* find(YulString _key) const
+	{
+		if (m_slots.empty())
+			return nullptr;
+		Slot const& slot = m_slots[slotIndex(_key)];
+		return slot.used ? &slot.value : nullptr;
+	}
+	T* find(YulString _key)
+	{
+		return const_cast<T*>(static_cast<YulStringMap const&>(*this).find(_key));
+	}
+	size_t count(YulString _key) const { return find(_key) ? 1 : 0; }
+
+	/// Removes @a _key from the map. @returns the number of removed elements.
+	size_t erase(YulString _key)
+	{
+		if (m_slots.empty())
+			return 0;
+		size_t hole = slotIndex(_key);
+		if (!m_slots[hole].used)
+			return 0;
+		// Move later elements of the same probe sequence into the hole, so that
+		// lookups do not need markers for removed elements.
+		for (size_t index = next(hole); m_slots[index].used; index = next(index))
+		{
+			size_t home = homeIndex(m_slots[index].key);
+			bool homeOutsideOfRange = hole <= index ?
+				(home <= hole || home > index) :
+				(home <= hole && home > index);
+			if (homeOutsideOfRange)
+			{
+				m_slots[hole] = std::move(m_slots[index]);
+				hole = index;
+			}
+		}
+		m_slots[hole] = Slot{};
+		--m_size;
+		return 1;
+	}
+
+	void clear() { m_slots.clear(); m_size = 0; }
+	void swap(YulStringMap& _other)
+	{
+		m_slots.swap(_other.m_slots);
+		std::swap(m_size, _other.m_size);
+		std::swap(m_bits, _other.m_bits);
+	}
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+
+private:
+	struct Slot
+	{
+		YulString key;
+		bool used = false;
+		T value{};
+	};
+
+	size_t homeIndex(YulString _key) const
+	{
+		// Fibonacci hashing spreads consecutive IDs over the table.
+		return size_t((std::uint64_t(_key.id()) * 0x9E3779B97F4A7C15ull) >> (64 - m_bits)) & (m_slots.size() - 1);
+	}
+	size_t next(size_t _index) const { return (_index + 1) & (m_slots.size() - 1); }
+	/// @returns the index of the slot that contains @a _key or of the empty slot where it
+	/// would be inserted. Requires at least one empty slot.
+	size_t slotIndex(YulString _key) const
+	{
+		size_t index = homeIndex(_key);
+		while (m_slots[index].used && m_slots[index].key != _key)
+			index = next(index);
+		return index;
+	}
+	void grow()
+	{
+		std::vector<Slot> slots(m_slots.empty() ? 16 : m_slots.size() * 2);
+		slots.swap(m_slots);
+		m_bits = 0;
+		while ((size_t(1) << m_bits) < m_slots.size())
+			++m_bits;
+		for (Slot& slot: slots)
+			if (slot.used)
+				m_slots[slotIndex(slot.key)] = std::move(slot);
+	}
+
+	std::vector<Slot> m_slots;
+	size_t m_size = 0;
+	/// Binary logarithm of the number of slots.
+	unsigned m_bits = 0;
+};
+
+}
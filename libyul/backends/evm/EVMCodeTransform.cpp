@@ -143,13 +143,16 @@ void CodeTransform::freeUnusedVariables()
 	if (!m_allowStackOpt)
 		return;
 
-	for (auto const& identifier: m_scope->identifiers)
-		if (identifier.second.type() == typeid(Scope::Variable))
-		{
-			Scope::Variable const& var = boost::get<Scope::Variable>(identifier.second);
-			if (m_variablesScheduledForDeletion.count(&var))
-				deleteVariable(var);
-		}
+	// This is called before every statement, so avoid iterating over scopes with many
+	// identifiers (like the outermost scope with all functions) if there is nothing to do.
+	if (!m_variablesScheduledForDeletion.empty())
+		for (auto const& identifier: m_scope->identifiers)
+			if (identifier.second.type() == typeid(Scope::Variable))
+			{
+				Scope::Variable const& var = boost::get<Scope::Variable>(identifier.second);
+				if (m_variablesScheduledForDeletion.count(&var))
+					deleteVariable(var);
+			}
 
 	while (m_unusedStackSlots.count(m_assembly.stackHeight() - 1))
 	{
@@ -0,0 +1,162 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Module providing a hash of a block of code to detect changes made by the optimiser
+ * and to find equal expressions.
+ */
+
+#include <libyul/optimiser/BlockHasher.h>
+
+#include <libyul/AsmData.h>
+#include <libyul/Utilities.h>
+
+using namespace std;
+using namespace yul;
+
+uint64_t BlockHasher::run(Block const& _block)
+{
+	BlockHasher hasher;
+	hasher(_block);
+	return hasher.m_hash;
+}
+
+uint64_t BlockHasher::run(FunctionDefinition const& _function)
+{
+	BlockHasher hasher;
+	hasher.hashTypedNames(_function.parameters);
+	hasher.hashTypedNames(_function.returnVariables);
+	hasher(_function.body);
+	return hasher.m_hash;
+}
+
+uint64_t BlockHasher::run(Expression const& _expression)
+{
+	BlockHasher hasher;
+	hasher.visit(_expression);
+	return hasher.m_hash;
+}
+
+void BlockHasher::operator()(Literal const& _literal)
+{
+	hashValue(static_cast<uint64_t>(_literal.kind));
+	string const& value = _literal.value.str();
+	// Only decimal numbers without leading zeros can be hashed as they are.
+	if (_literal.kind == LiteralKind::Number && value.size() > 1 && value[0] == '0')
+		hashValue(YulStringRepository::hash(valueOfNumberLiteral(_literal).str()));
+	else
+		hashName(_literal.value);
+	hashName(_literal.type);
+}
+
+void BlockHasher::operator()(Identifier const& _identifier)
+{
+	hashReference(_identifier.name);
+}
+
+void BlockHasher::operator()(FunctionalInstruction const& _instr)
+{
+	hashValue(static_cast<uint64_t>(_instr.instruction));
+	hashValue(_instr.arguments.size());
+	ASTWalker::operator()(_instr);
+}
+
+void BlockHasher::operator()(FunctionCall const& _funCall)
+{
+	hashName(_funCall.functionName.name);
+	hashValue(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
+
+void BlockHasher::operator()(Assignment const& _assignment)
+{
+	hashValue(_assignment.variableNames.size());
+	for (auto const& name: _assignment.variableNames)
+		hashReference(name.name);
+	ASTWalker::operator()(_assignment);
+}
+
+void BlockHasher::operator()(VariableDeclaration const& _varDecl)
+{
+	hashTypedNames(_varDecl.variables);
+	hashValue(_varDecl.value ? 1 : 0);
+	ASTWalker::operator()(_varDecl);
+}
+
+void BlockHasher::operator()(Switch const& _switch)
+{
+	hashValue(_switch.cases.size());
+	for (auto const& _case: _switch.cases)
+		hashValue(_case.value ? 1 : 0);
+	ASTWalker::operator()(_switch);
+}
+
+void BlockHasher::operator()(FunctionDefinition const& _fun)
+{
+	hashName(_fun.name);
+	hashTypedNames(_fun.parameters);
+	hashTypedNames(_fun.returnVariables);
+	ASTWalker::operator()(_fun);
+}
+
+void BlockHasher::operator()(Block const& _block)
+{
+	hashValue(_block.statements.size());
+	ASTWalker::operator()(_block);
+}
+
+void BlockHasher::visit(Statement const& _statement)
+{
+	hashValue(_statement.which());
+	ASTWalker::visit(_statement);
+}
+
+void BlockHasher::visit(Expression const& _expression)
+{
+	hashValue(_expression.which());
+	ASTWalker::visit(_expression);
+}
+
+void BlockHasher::hashValue(uint64_t _value)
+{
+	// Same mixing as boost::hash_combine, widened to 64 bits.
+	m_hash ^= _value + 0x9e3779b97f4a7c15u + (m_hash << 6) + (m_hash >> 2);
+}
+
+void BlockHasher::hashName(YulString _name)
+{
+	hashValue(_name.hash());
+}
+
+void BlockHasher::hashReference(YulString _name)
+{
+	if (uint64_t const* number = m_variables.find(_name))
+		hashValue(*number);
+	else
+		hashName(_name);
+}
+
+void BlockHasher::hashTypedNames(vector<TypedName> const& _names)
+{
+	hashValue(_names.size());
+	for (auto const& name: _names)
+	{
+		uint64_t number = m_variables.size();
+		m_variables[name.name] = number;
+		hashValue(number);
+		hashName(name.type);
+	}
+}
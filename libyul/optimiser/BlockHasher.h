@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Module providing a hash of a block of code to detect changes made by the optimiser
+ * and to find equal expressions.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/YulStringMap.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace yul
+{
+
+/**
+ * Computes a hash of the code of a block including its functions.
+ * The hash covers the structure of the code, names of functions and literals, but not
+ * source locations and names of variables: Variables declared inside the block are
+ * identified by the order of their declarations, so that code that only differs in the
+ * names of its variables (like after running the SSA transform again) has the same hash.
+ * Number literals are hashed by their value. It is deterministic, i.e. it does not depend
+ * on the order in which YulStrings were created.
+ *
+ * Code that is syntactically equal (see SyntacticallyEqual) has the same hash. Since
+ * collisions are possible, equal hashes only mean that the code is very likely to be equal.
+ *
+ * Prerequisite: Disambiguator
+ */
+class BlockHasher: public ASTWalker
+{
+public:
+	static std::uint64_t run(Block const& _block);
+	/// @returns the hash of the parameters, return variables and body of @a _function,
+	/// i.e. ignores its name.
+	static std::uint64_t run(FunctionDefinition const& _function);
+	/// @returns the hash of @a _expression. Since it does not declare variables, all
+	/// identifiers are hashed by their names, i.e. syntactically equal expressions
+	/// have the same hash.
+	static std::uint64_t run(Expression const& _expression);
+
+	using ASTWalker::operator();
+	void operator()(Literal const& _literal) override;
+	void operator()(Identifier const& _identifier) override;
+	void operator()(FunctionalInstruction const& _instr) override;
+	void operator()(FunctionCall const& _funCall) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const& _fun) override;
+	void operator()(Block const& _block) override;
+
+	void visit(Statement const& _statement) override;
+	void visit(Expression const& _expression) override;
+
+private:
+	BlockHasher() = default;
+
+	void hashValue(std::uint64_t _value);
+	void hashName(YulString _name);
+	/// Hashes a reference to a variable or function.
+	void hashReference(YulString _name);
+	void hashTypedNames(std::vector<TypedName> const& _names);
+
+	/// Numbers of the variables declared so far.
+	YulStringMap<std::uint64_t> m_variables;
+	std::uint64_t m_hash = YulStringRepository::emptyHash();
+};
+
+}
@@ -21,7 +21,7 @@
 
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 
-#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AsmData.h>
@@ -31,6 +31,15 @@ using namespace std;
 using namespace dev;
 using namespace yul;
 
+void CommonSubexpressionEliminator::operator()(FunctionDefinition& _fun)
+{
+	// The values of the surrounding code are not available inside the function.
+	map<uint64_t, set<YulString>> replacementCandidates;
+	m_replacementCandidates.swap(replacementCandidates);
+	DataFlowAnalyzer::operator()(_fun);
+	m_replacementCandidates.swap(replacementCandidates);
+}
+
 void CommonSubexpressionEliminator::visit(Expression& _e)
 {
 	bool descend = true;
@@ -69,16 +78,30 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 	}
 	else
 	{
-		// TODO this search is rather inefficient.
-		for (auto const& var: m_value)
+		auto candidates = m_replacementCandidates.find(BlockHasher::run(_e));
+		if (candidates == m_replacementCandidates.end())
+			return;
+		// The candidates are sorted like m_value, so the same variable is chosen as if
+		// all values were searched.
+		for (YulString variable: candidates->second)
 		{
-			assertThrow(var.second, OptimizerException, "");
-			assertThrow(inScope(var.first), OptimizerException, "");
-			if (SyntacticallyEqual{}(_e, *var.second))
+			auto value = m_value.find(variable);
+			if (value == m_value.end())
+				continue;
+			assertThrow(value->second, OptimizerException, "");
+			assertThrow(inScope(variable), OptimizerException, "");
+			if (SyntacticallyEqual{}(_e, *value->second))
 			{
-				_e = Identifier{locationOf(_e), var.first};
+				_e = Identifier{locationOf(_e), variable};
 				break;
 			}
 		}
 	}
 }
+
+void CommonSubexpressionEliminator::assignValue(YulString _variable, Expression const* _value)
+{
+	assertThrow(_value, OptimizerException, "");
+	m_replacementCandidates[BlockHasher::run(*_value)].insert(_variable);
+	DataFlowAnalyzer::assignValue(_variable, _value);
+}
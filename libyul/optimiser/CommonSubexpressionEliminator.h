@@ -23,6 +23,10 @@
 
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 
+#include <cstdint>
+#include <map>
+#include <set>
+
 namespace yul
 {
 
@@ -32,6 +36,9 @@ struct Dialect;
  * Optimisation stage that replaces expressions known to be the current value of a variable
  * in scope by a reference to that variable.
  *
+ * The candidate variables for an expression are found via a hash of the values of the
+ * variables, so that the run time does not depend on the number of known values.
+ *
  * Prerequisite: Disambiguator
  */
 class CommonSubexpressionEliminator: public DataFlowAnalyzer
@@ -39,9 +46,19 @@ class CommonSubexpressionEliminator: public DataFlowAnalyzer
 public:
 	CommonSubexpressionEliminator(Dialect const& _dialect): DataFlowAnalyzer(_dialect) {}
 
+	using DataFlowAnalyzer::operator();
+	void operator()(FunctionDefinition& _fun) override;
+
 protected:
 	using ASTModifier::visit;
 	void visit(Expression& _e) override;
+
+	void assignValue(YulString _variable, Expression const* _value) override;
+
+private:
+	/// Variables by the hash of the values assigned to them. Since the values are not removed
+	/// when they are cleared or overwritten, the candidates have to be checked against m_value.
+	std::map<std::uint64_t, std::set<YulString>> m_replacementCandidates;
 };
 
 }
@@ -88,8 +88,8 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	// Save all information. We might rather reinstantiate this class,
 	// but this could be difficult if it is subclassed.
 	map<YulString, Expression const*> value;
-	map<YulString, set<YulString>> references;
-	map<YulString, set<YulString>> referencedBy;
+	YulStringMap<set<YulString>> references;
+	YulStringMap<set<YulString>> referencedBy;
 	m_value.swap(value);
 	m_references.swap(references);
 	m_referencedBy.swap(referencedBy);
@@ -153,7 +153,7 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 		movableChecker.visit(*_value);
 	else
 		for (auto const& var: _variables)
-			m_value[var] = &zero;
+			assignValue(var, &zero);
 
 	if (_value && _variables.size() == 1)
 	{
@@ -161,7 +161,7 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 		// Expression has to be movable and cannot contain a reference
 		// to the variable that will be assigned to.
 		if (movableChecker.movable() && !movableChecker.referencedVariables().count(name))
-			m_value[name] = _value;
+			assignValue(name, _value);
 	}
 
 	auto const& referencedVariables = movableChecker.referencedVariables();
@@ -173,6 +173,11 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 	}
 }
 
+void DataFlowAnalyzer::assignValue(YulString _variable, Expression const* _value)
+{
+	m_value[_variable] = _value;
+}
+
 void DataFlowAnalyzer::pushScope(bool _functionScope)
 {
 	m_variableScopes.emplace_back(_functionScope);
@@ -24,6 +24,7 @@
 
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/YulString.h>
+#include <libyul/YulStringMap.h>
 
 #include <map>
 #include <set>
@@ -59,6 +60,10 @@ protected:
 	/// Registers the assignment.
 	void handleAssignment(std::set<YulString> const& _names, Expression* _value);
 
+	/// Sets the current value of the variable, which has been cleared before.
+	/// Can be overridden to keep track of the values, but has to call this function.
+	virtual void assignValue(YulString _variable, Expression const* _value);
+
 	/// Creates a new inner scope.
 	void pushScope(bool _functionScope);
 
@@ -75,9 +80,9 @@ protected:
 	/// Current values of variables, always movable.
 	std::map<YulString, Expression const*> m_value;
 	/// m_references[a].contains(b) <=> the current expression assigned to a references b
-	std::map<YulString, std::set<YulString>> m_references;
+	YulStringMap<std::set<YulString>> m_references;
 	/// m_referencedBy[b].contains(a) <=> the current expression assigned to a references b
-	std::map<YulString, std::set<YulString>> m_referencedBy;
+	YulStringMap<std::set<YulString>> m_referencedBy;
 
 	struct Scope
 	{
@@ -19,10 +19,10 @@
  */
 
 #include <libyul/optimiser/EquivalentFunctionDetector.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
 
 #include <libyul/AsmData.h>
-#include <libyul/optimiser/Metrics.h>
 
 using namespace std;
 using namespace dev;
@@ -30,8 +30,7 @@ using namespace yul;
 
 void EquivalentFunctionDetector::operator()(FunctionDefinition const& _fun)
 {
-	RoughHeuristic heuristic(_fun);
-	auto& candidates = m_candidates[heuristic];
+	auto& candidates = m_candidates[BlockHasher::run(_fun)];
 	for (auto const& candidate: candidates)
 		if (SyntacticallyEqual{}.statementEqual(_fun, *candidate))
 		{
@@ -40,23 +39,3 @@ void EquivalentFunctionDetector::operator()(FunctionDefinition const& _fun)
 		}
 	candidates.push_back(&_fun);
 }
-
-bool EquivalentFunctionDetector::RoughHeuristic::operator<(EquivalentFunctionDetector::RoughHeuristic const& _rhs) const
-{
-	if (
-		std::make_tuple(m_fun.parameters.size(), m_fun.returnVariables.size()) ==
-		std::make_tuple(_rhs.m_fun.parameters.size(), _rhs.m_fun.returnVariables.size())
-	)
-		return codeSize() < _rhs.codeSize();
-	else
-		return
-			std::make_tuple(m_fun.parameters.size(), m_fun.returnVariables.size()) <
-			std::make_tuple(_rhs.m_fun.parameters.size(), _rhs.m_fun.returnVariables.size());
-}
-
-size_t EquivalentFunctionDetector::RoughHeuristic::codeSize() const
-{
-	if (!m_codeSize)
-		m_codeSize = CodeSize::codeSize(m_fun.body);
-	return *m_codeSize;
-}
@@ -22,6 +22,8 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/AsmDataForward.h>
 
+#include <cstdint>
+
 namespace yul
 {
 
@@ -45,25 +47,9 @@ public:
 
 private:
 	EquivalentFunctionDetector() = default;
-	/**
-	 * Fast heuristic to detect distinct, resp. potentially equal functions.
-	 *
-	 * Defines a partial order on function definitions. If two functions
-	 * are comparable (one is "less" than the other), they are distinct.
-	 * If not (neither is "less" than the other), they are *potentially* equal.
-	 */
-	class RoughHeuristic
-	{
-	public:
-		RoughHeuristic(FunctionDefinition const& _fun): m_fun(_fun) {}
-		bool operator<(RoughHeuristic const& _rhs) const;
-	private:
-		std::size_t codeSize() const;
-		FunctionDefinition const& m_fun;
-		mutable boost::optional<std::size_t> m_codeSize;
-		// In case the heuristic doesn't turn out to be good enough, we might want to define a hash function for code blocks.
-	};
-	std::map<RoughHeuristic, std::vector<FunctionDefinition const*>> m_candidates;
+	/// Functions by the hash of their code (see BlockHasher). Only functions with the
+	/// same hash can be equal.
+	std::map<std::uint64_t, std::vector<FunctionDefinition const*>> m_candidates;
 	std::map<YulString, FunctionDefinition const*> m_duplicates;
 };
 
@@ -39,8 +39,8 @@ class FunctionGrouper
 public:
 	void operator()(Block& _block);
 
-private:
-	bool alreadyGrouped(Block const& _block);
+	/// @returns true if @a _block is already of the form described above.
+	static bool alreadyGrouped(Block const& _block);
 };
 
 }
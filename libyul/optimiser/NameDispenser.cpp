@@ -39,12 +39,30 @@ NameDispenser::NameDispenser(Dialect const& _dialect, set<YulString> _usedNames)
 {
 }
 
+NameDispenser::NameDispenser(
+	Dialect const& _dialect,
+	shared_ptr<set<YulString> const> _sharedUsedNames,
+	size_t _counterOffset,
+	size_t _counterStride
+):
+	m_dialect(_dialect),
+	m_sharedUsedNames(std::move(_sharedUsedNames)),
+	m_counter(_counterOffset),
+	m_counterStride(_counterStride)
+{
+}
+
 YulString NameDispenser::newName(YulString _nameHint)
 {
 	YulString name = _nameHint;
-	while (name.empty() || m_usedNames.count(name) || m_dialect.builtin(name))
+	while (
+		name.empty() ||
+		m_usedNames.count(name) ||
+		(m_sharedUsedNames && m_sharedUsedNames->count(name)) ||
+		m_dialect.builtin(name)
+	)
 	{
-		m_counter++;
+		m_counter += m_counterStride;
 		name = YulString(_nameHint.str() + "_" + to_string(m_counter));
 	}
 	m_usedNames.emplace(name);
@@ -23,6 +23,7 @@
 
 #include <libyul/YulString.h>
 
+#include <memory>
 #include <set>
 
 namespace yul
@@ -42,6 +43,15 @@ public:
 	explicit NameDispenser(Dialect const& _dialect, Block const& _ast);
 	/// Initialize the name dispenser with the given used names.
 	explicit NameDispenser(Dialect const& _dialect, std::set<YulString> _usedNames);
+	/// Initialize the name dispenser with used names that are shared with other name dispensers
+	/// creating names concurrently. All of them have to use the same @a _counterStride and distinct
+	/// offsets below it, so that they append distinct numbers and cannot create the same name.
+	NameDispenser(
+		Dialect const& _dialect,
+		std::shared_ptr<std::set<YulString> const> _sharedUsedNames,
+		size_t _counterOffset,
+		size_t _counterStride
+	);
 
 	/// @returns a currently unused name that should be similar to _nameHint.
 	YulString newName(YulString _nameHint);
@@ -50,7 +60,9 @@ private:
 
 	Dialect const& m_dialect;
 	std::set<YulString> m_usedNames;
+	std::shared_ptr<std::set<YulString> const> m_sharedUsedNames;
 	size_t m_counter = 0;
+	size_t m_counterStride = 1;
 };
 
 }
@@ -64,7 +64,7 @@ protected:
 	using ASTModifier::visit;
 	void visit(Expression& _e) override;
 
-	std::map<YulString, size_t> m_referenceCounts;
+	YulStringMap<size_t> m_referenceCounts;
 	std::set<YulString> m_varsToAlwaysRematerialize;
 };
 
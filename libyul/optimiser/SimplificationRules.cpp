@@ -44,7 +44,8 @@ SimplificationRule<yul::Pattern> const* SimplificationRules::findFirstMatch(
 	if (_expr.type() != typeid(FunctionalInstruction))
 		return nullptr;
 
-	static SimplificationRules rules;
+	// The rules store their match groups, so every thread needs its own copy.
+	static thread_local SimplificationRules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	FunctionalInstruction const& instruction = boost::get<FunctionalInstruction>(_expr);
@@ -32,6 +32,8 @@
 
 #include <libyul/AsmData.h>
 
+#include <libdevcore/Common.h>
+
 using namespace std;
 using namespace dev;
 using namespace yul;
@@ -130,6 +132,49 @@ void eliminateVariables(shared_ptr<Dialect> const& _dialect, ASTNode& _node, siz
 	UnusedPruner::runUntilStabilised(*_dialect, _node);
 }
 
+/// Runs the CompilabilityChecker only for the parts of the code in @a _parts, where the
+/// main block is given by the empty name, and @returns their stack surplus.
+/// Since the code transform handles the main block and the functions of grouped code
+/// independently of each other, the code of all other parts, including the main block
+/// if it is not in @a _parts, is removed during the check, which avoids generating code
+/// for them again.
+map<YulString, int> partialStackSurplus(
+	shared_ptr<Dialect> const& _dialect,
+	Block& _ast,
+	bool _optimizeStackAllocation,
+	set<YulString> const& _parts
+)
+{
+	map<YulString, Block*> code{{YulString{}, &boost::get<Block>(_ast.statements.at(0))}};
+	for (size_t i = 1; i < _ast.statements.size(); ++i)
+	{
+		FunctionDefinition& fun = boost::get<FunctionDefinition>(_ast.statements[i]);
+		code[fun.name] = &fun.body;
+	}
+
+	map<YulString, Block> removedCode;
+	map<YulString, int> stackSurplus;
+	{
+		// Put the removed code back even if the check throws.
+		ScopeGuard restoreCode([&]()
+		{
+			for (auto& removed: removedCode)
+				swap(*code.at(removed.first), removed.second);
+		});
+		for (auto const& part: code)
+			if (!_parts.count(part.first))
+				swap(*part.second, removedCode[part.first]);
+		stackSurplus = CompilabilityChecker::run(_dialect, _ast, _optimizeStackAllocation);
+	}
+
+	for (auto it = stackSurplus.begin(); it != stackSurplus.end();)
+		if (_parts.count(it->first))
+			++it;
+		else
+			it = stackSurplus.erase(it);
+	return stackSurplus;
+}
+
 }
 
 bool StackCompressor::run(
@@ -143,11 +188,26 @@ bool StackCompressor::run(
 		_ast.statements.size() > 0 && _ast.statements.at(0).type() == typeid(Block),
 		"Need to run the function grouper before the stack compressor."
 	);
+	// Parts of the code that are compilable do not change, so only the parts that had
+	// a stack surplus have to be checked again.
+	bool checkAll = true;
+	set<YulString> partsToCheck;
 	for (size_t iterations = 0; iterations < _maxIterations; iterations++)
 	{
-		map<YulString, int> stackSurplus = CompilabilityChecker::run(_dialect, _ast, _optimizeStackAllocation);
+		map<YulString, int> stackSurplus = checkAll ?
+			CompilabilityChecker::run(_dialect, _ast, _optimizeStackAllocation) :
+			partialStackSurplus(_dialect, _ast, _optimizeStackAllocation, partsToCheck);
 		if (stackSurplus.empty())
 			return true;
+		// The code transform stops at the first error in the main block, so the functions
+		// have only been checked if the main block is compilable.
+		if (!stackSurplus.count(YulString{}))
+		{
+			checkAll = false;
+			partsToCheck.clear();
+			for (auto const& surplus: stackSurplus)
+				partsToCheck.insert(surplus.first);
+		}
 
 		if (stackSurplus.count(YulString{}))
 		{
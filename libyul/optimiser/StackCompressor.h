@@ -34,6 +34,9 @@ struct FunctionDefinition;
  * Optimisation stage that aggressively rematerializes certain variables in a function to free
  * space on the stack until it is compilable.
  *
+ * After the first iteration, only the functions (and the main block) that were modified are
+ * checked for compilability again.
+ *
  * Prerequisite: Disambiguator, Function Grouper
  */
 class StackCompressor
@@ -23,6 +23,7 @@
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/DeadCodeEliminator.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
@@ -42,165 +43,377 @@
 #include <libyul/optimiser/StructuralSimplifier.h>
 #include <libyul/optimiser/RedundantAssignEliminator.h>
 #include <libyul/optimiser/VarNameCleaner.h>
-#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmData.h>
 #include <libyul/AsmPrinter.h>
+#include <libyul/Exceptions.h>
 
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libdevcore/CommonData.h>
+#include <libdevcore/Profiler.h>
+#include <libdevcore/ThreadPool.h>
+
+#include <algorithm>
+#include <cctype>
+#include <unordered_set>
 
 using namespace std;
 using namespace dev;
 using namespace yul;
 
-void OptimiserSuite::run(
-	shared_ptr<Dialect> const& _dialect,
-	Block& _ast,
-	AsmAnalysisInfo const& _analysisInfo,
-	bool _optimizeStackAllocation,
-	set<YulString> const& _externallyUsedIdentifiers
-)
+namespace
 {
-	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
 
-	Block ast = boost::get<Block>(Disambiguator(*_dialect, _analysisInfo, reservedIdentifiers)(_ast));
+/// Runs @a _step, which is recorded as the phase @a _name by the active profiler.
+template <typename Step>
+void runStep(char const* _name, Step const& _step)
+{
+	ProfilerPhase phase(_name);
+	_step();
+}
 
-	VarDeclInitializer{}(ast);
-	FunctionHoister{}(ast);
-	BlockFlattener{}(ast);
-	DeadCodeEliminator{}(ast);
-	FunctionGrouper{}(ast);
-	EquivalentFunctionCombiner::run(ast);
-	UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-	ForLoopInitRewriter{}(ast);
-	BlockFlattener{}(ast);
-	StructuralSimplifier{*_dialect}(ast);
-	BlockFlattener{}(ast);
+/// State shared by the steps of one run of the suite.
+struct StepContext
+{
+	StepContext(Dialect const& _dialect, Block& _ast, set<YulString> const& _reservedIdentifiers):
+		dialect(_dialect), ast(_ast), reservedIdentifiers(_reservedIdentifiers)
+	{}
 
-	// None of the above can make stack problems worse.
+	Dialect const& dialect;
+	/// The whole code or, when optimising functions separately, a single function or
+	/// the main block.
+	Block& ast;
+	set<YulString> const& reservedIdentifiers;
+	bool separateFunctions = false;
+	unsigned jobs = 1;
+	/// Names used in all of the code if this context only covers a part of it.
+	shared_ptr<set<YulString> const> sharedUsedNames;
+	size_t counterOffset = 0;
+	size_t counterStride = 1;
+	/// Name dispenser for all of the code if this context covers a part of it and the
+	/// parts are optimised one after the other.
+	NameDispenser* sharedDispenser = nullptr;
+	unique_ptr<NameDispenser> dispenser;
 
-	NameDispenser dispenser{*_dialect, ast};
+	/// Hashes of code (the whole code, the main block or a function) that was not changed
+	/// by a sequence of steps. Applying the same steps again to such code is skipped.
+	/// Since the hashes ignore variable names, this also covers the same code after a
+	/// round of the optimiser that only renamed variables.
+	map<string, unordered_set<uint64_t>> unchanged;
+	/// Hash of the whole code, if known.
+	boost::optional<uint64_t> astHash;
+	/// Hashes of the main block and the functions of the grouped code, if known.
+	vector<uint64_t> partHashes;
 
-	size_t codeSize = 0;
-	for (size_t rounds = 0; rounds < 12; ++rounds)
+	uint64_t wholeCodeHash()
 	{
-		{
-			size_t newSize = CodeSize::codeSizeIncludingFunctions(ast);
-			if (newSize == codeSize)
-				break;
-			codeSize = newSize;
-		}
+		if (!astHash)
+			astHash = BlockHasher::run(ast);
+		return *astHash;
+	}
 
-		{
-			// Turn into SSA and simplify
-			ExpressionSplitter{*_dialect, dispenser}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			RedundantAssignEliminator::run(*_dialect, ast);
-
-			ExpressionSimplifier::run(*_dialect, ast);
-			CommonSubexpressionEliminator{*_dialect}(ast);
-		}
+	/// @returns the name dispenser, which is only created once a step needs new names,
+	/// so that it knows about all names that are still used at that point.
+	NameDispenser& nameDispenser()
+	{
+		if (sharedDispenser)
+			return *sharedDispenser;
+		if (!dispenser)
+			dispenser = sharedUsedNames ?
+				make_unique<NameDispenser>(dialect, sharedUsedNames, counterOffset, counterStride) :
+				make_unique<NameDispenser>(dialect, ast);
+		return *dispenser;
+	}
+};
 
-		{
-			// still in SSA, perform structural simplification
-			StructuralSimplifier{*_dialect}(ast);
-			BlockFlattener{}(ast);
-			DeadCodeEliminator{}(ast);
-			UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-		}
-		{
-			// simplify again
-			CommonSubexpressionEliminator{*_dialect}(ast);
-			UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-		}
+struct Step
+{
+	char abbreviation;
+	/// Name of the step prefixed by "yul/", which is the name of its profiler phase.
+	char const* phase;
+	/// True if the step only depends on and modifies the individual functions and the main
+	/// block, so that it can be applied to them separately.
+	bool functionLocal;
+	bool createsNames;
+	void (*run)(StepContext&);
+};
 
-		{
-			// reverse SSA
-			SSAReverser::run(ast);
-			CommonSubexpressionEliminator{*_dialect}(ast);
-			UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
+Step const steps[] = {
+	{'f', "yul/BlockFlattener", true, false, [](StepContext& _c) { BlockFlattener{}(_c.ast); }},
+	{'c', "yul/CommonSubexpressionEliminator", true, false, [](StepContext& _c) { CommonSubexpressionEliminator{_c.dialect}(_c.ast); }},
+	{'D', "yul/DeadCodeEliminator", true, false, [](StepContext& _c) { DeadCodeEliminator{}(_c.ast); }},
+	{'v', "yul/EquivalentFunctionCombiner", false, false, [](StepContext& _c) { EquivalentFunctionCombiner::run(_c.ast); }},
+	{'e', "yul/ExpressionInliner", false, false, [](StepContext& _c) { ExpressionInliner(_c.dialect, _c.ast).run(); }},
+	{'j', "yul/ExpressionJoiner", true, false, [](StepContext& _c) { ExpressionJoiner::run(_c.ast); }},
+	{'s', "yul/ExpressionSimplifier", true, false, [](StepContext& _c) { ExpressionSimplifier::run(_c.dialect, _c.ast); }},
+	{'x', "yul/ExpressionSplitter", true, true, [](StepContext& _c) { ExpressionSplitter{_c.dialect, _c.nameDispenser()}(_c.ast); }},
+	{'o', "yul/ForLoopInitRewriter", true, false, [](StepContext& _c) { ForLoopInitRewriter{}(_c.ast); }},
+	{'i', "yul/FullInliner", false, true, [](StepContext& _c) { FullInliner{_c.ast, _c.nameDispenser()}.run(); }},
+	{'g', "yul/FunctionGrouper", false, false, [](StepContext& _c) { FunctionGrouper{}(_c.ast); }},
+	{'h', "yul/FunctionHoister", false, false, [](StepContext& _c) { FunctionHoister{}(_c.ast); }},
+	{'r', "yul/RedundantAssignEliminator", true, false, [](StepContext& _c) { RedundantAssignEliminator::run(_c.dialect, _c.ast); }},
+	{'m', "yul/Rematerialiser", true, false, [](StepContext& _c) { Rematerialiser::run(_c.dialect, _c.ast); }},
+	{'V', "yul/SSAReverser", true, false, [](StepContext& _c) { SSAReverser::run(_c.ast); }},
+	{'a', "yul/SSATransform", true, true, [](StepContext& _c) { SSATransform::run(_c.ast, _c.nameDispenser()); }},
+	{'t', "yul/StructuralSimplifier", true, false, [](StepContext& _c) { StructuralSimplifier{_c.dialect}(_c.ast); }},
+	{'u', "yul/UnusedPruner", false, false, [](StepContext& _c) { UnusedPruner::runUntilStabilised(_c.dialect, _c.ast, _c.reservedIdentifiers); }},
+	{'d', "yul/VarDeclInitializer", true, false, [](StepContext& _c) { VarDeclInitializer{}(_c.ast); }}
+};
 
-			ExpressionJoiner::run(ast);
-			ExpressionJoiner::run(ast);
-		}
+Step const* findStep(char _abbreviation)
+{
+	for (Step const& step: steps)
+		if (step.abbreviation == _abbreviation)
+			return &step;
+	return nullptr;
+}
 
-		// should have good "compilability" property here.
+bool isFunctionLocal(char _abbreviation)
+{
+	Step const* step = findStep(_abbreviation);
+	return step && step->functionLocal;
+}
 
-		{
-			// run functional expression inliner
-			ExpressionInliner(*_dialect, ast).run();
-			UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-		}
+/// Runs @a _step on the whole code unless it did not change the same code before.
+void runOnWholeCode(StepContext& _context, Step const& _step)
+{
+	unordered_set<uint64_t>& unchanged = _context.unchanged[string(1, _step.abbreviation)];
+	uint64_t const previousHash = _context.wholeCodeHash();
+	if (unchanged.count(previousHash))
+		return;
+
+	runStep(_step.phase, [&]() { _step.run(_context); });
 
+	uint64_t hash = BlockHasher::run(_context.ast);
+	if (hash == previousHash)
+		unchanged.insert(hash);
+	else
+	{
+		_context.astHash = hash;
+		_context.partHashes.clear();
+	}
+}
+
+/// Runs the function-local steps @a _steps on the main block and each function of the
+/// grouped code separately, skipping the parts that the same steps did not change before.
+/// The code is never flattened into the outermost block, so it stays grouped.
+///
+/// When optimising functions separately, up to _context.jobs parts are processed
+/// concurrently. Each part then gets its own name dispenser that appends numbers not
+/// used by the others, which makes the result independent of the number of jobs.
+/// Otherwise, @a _steps is a single step and the parts are processed one after the other
+/// with the name dispenser of the whole code, which gives the same result as applying
+/// the step to the whole code.
+void runOnFunctions(StepContext& _context, string const& _steps)
+{
+	vector<Statement>& statements = _context.ast.statements;
+	bool createsNames = any_of(_steps.begin(), _steps.end(), [](char _c) {
+		return findStep(_c)->createsNames;
+	});
+	shared_ptr<set<YulString> const> usedNames;
+	if (createsNames && _context.separateFunctions)
+		usedNames = make_shared<set<YulString> const>(NameCollector(_context.ast).names());
+	else if (createsNames)
+		// Has to be created while the dispenser can still see all of the code.
+		_context.nameDispenser();
+
+	// The main block is optimised as it is, the functions inside a block of their own.
+	vector<Block> parts;
+	parts.emplace_back(std::move(boost::get<Block>(statements.front())));
+	for (size_t i = 1; i < statements.size(); ++i)
+	{
+		parts.emplace_back(Block{locationOf(statements[i]), {}});
+		parts.back().statements.emplace_back(std::move(statements[i]));
+	}
+
+	unordered_set<uint64_t>& unchanged = _context.unchanged[_steps];
+	vector<uint64_t>& hashes = _context.partHashes;
+	bool const hashesKnown = hashes.size() == parts.size();
+	if (!hashesKnown)
+		hashes.assign(parts.size(), 0);
+	enum class Outcome { Skipped, Unchanged, Changed };
+	vector<Outcome> outcomes(parts.size(), Outcome::Skipped);
+
+	string const profilerContext = ProfilerContext::current();
+	ThreadPool pool(_context.separateFunctions ? _context.jobs : 1);
+	for (size_t i = 0; i < parts.size(); ++i)
+		pool.schedule([&, i]() {
+			if (!hashesKnown)
+				hashes[i] = BlockHasher::run(parts[i]);
+			if (unchanged.count(hashes[i]))
+				return;
+
+			ProfilerContext context(profilerContext);
+			StepContext partContext(_context.dialect, parts[i], _context.reservedIdentifiers);
+			if (_context.separateFunctions)
+			{
+				partContext.sharedUsedNames = usedNames;
+				partContext.counterOffset = i;
+				partContext.counterStride = parts.size();
+			}
+			else
+				partContext.sharedDispenser = _context.dispenser.get();
+			for (char abbreviation: _steps)
+			{
+				Step const* step = findStep(abbreviation);
+				runStep(step->phase, [&]() { step->run(partContext); });
+			}
+
+			uint64_t hash = BlockHasher::run(parts[i]);
+			outcomes[i] = hash == hashes[i] ? Outcome::Unchanged : Outcome::Changed;
+			hashes[i] = hash;
+		});
+	pool.wait();
+
+	statements.front() = std::move(parts.front());
+	for (size_t i = 1; i < statements.size(); ++i)
+		statements[i] = std::move(parts[i].statements.front());
+
+	for (size_t i = 0; i < parts.size(); ++i)
+		if (outcomes[i] == Outcome::Unchanged)
+			unchanged.insert(hashes[i]);
+	if (count(outcomes.begin(), outcomes.end(), Outcome::Changed))
+		_context.astHash.reset();
+	// The shared name dispenser does not know the new names.
+	if (createsNames && _context.separateFunctions)
+		_context.dispenser.reset();
+}
+
+/// Runs the steps in the range [@a _begin, @a _end) of a validated step sequence.
+void runSteps(StepContext& _context, string::const_iterator _begin, string::const_iterator _end)
+{
+	for (auto it = _begin; it != _end;)
+		if (*it == '[')
 		{
-			// Turn into SSA again and simplify
-			ExpressionSplitter{*_dialect, dispenser}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			CommonSubexpressionEliminator{*_dialect}(ast);
+			auto groupEnd = find(it, _end, ']');
+			// Stop once a round did not change anything apart from variable names,
+			// since the next round would then not lead to anything new either.
+			boost::optional<uint64_t> previousHash;
+			for (size_t rounds = 0; rounds < OptimiserSuite::maxRounds; ++rounds)
+			{
+				uint64_t hash = _context.wholeCodeHash();
+				if (hash == previousHash)
+					break;
+				previousHash = hash;
+				runSteps(_context, it + 1, groupEnd);
+			}
+			it = groupEnd + 1;
 		}
-
+		else if (isFunctionLocal(*it) && FunctionGrouper::alreadyGrouped(_context.ast))
 		{
-			// run full inliner
-			FunctionGrouper{}(ast);
-			EquivalentFunctionCombiner::run(ast);
-			FullInliner{ast, dispenser}.run();
-			BlockFlattener{}(ast);
+			auto segmentEnd = !_context.separateFunctions ? it + 1 : find_if(it, _end, [](char _c) {
+				return !isFunctionLocal(_c) && !isspace(static_cast<unsigned char>(_c));
+			});
+			string segment;
+			copy_if(it, segmentEnd, back_inserter(segment), [](char _c) { return !isspace(static_cast<unsigned char>(_c)); });
+			runOnFunctions(_context, segment);
+			it = segmentEnd;
 		}
-
+		else
 		{
-			// SSA plus simplify
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			ExpressionSimplifier::run(*_dialect, ast);
-			StructuralSimplifier{*_dialect}(ast);
-			BlockFlattener{}(ast);
-			DeadCodeEliminator{}(ast);
-			CommonSubexpressionEliminator{*_dialect}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			RedundantAssignEliminator::run(*_dialect, ast);
-			UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-			CommonSubexpressionEliminator{*_dialect}(ast);
+			if (Step const* step = findStep(*it))
+				runOnWholeCode(_context, *step);
+			++it;
 		}
-	}
+}
+}
 
+char const* const OptimiserSuite::DefaultSteps =
+	"dhfDgvuoftf"
+	// None of the above can make stack problems worse.
+	"["
+		"xarrsc" // Turn into SSA and simplify
+		"tfDu" // still in SSA, perform structural simplification
+		"cu" // simplify again
+		"Vcujj" // reverse SSA
+		// should have good "compilability" property here.
+		"eu" // run functional expression inliner
+		"xarrc" // Turn into SSA again and simplify
+		"gvif" // run full inliner
+		"arrstfDcarruc" // SSA plus simplify
+	"]"
 	// Make source short and pretty.
+	"jmujuju"
+	"Vcu"
+	"jmu";
+
+void OptimiserSuite::run(
+	shared_ptr<Dialect> const& _dialect,
+	Block& _ast,
+	AsmAnalysisInfo const& _analysisInfo,
+	bool _optimizeStackAllocation,
+	set<YulString> const& _externallyUsedIdentifiers,
+	string const& _steps,
+	bool _separateFunctions,
+	unsigned _jobs
+)
+{
+	validateSteps(_steps);
 
-	ExpressionJoiner::run(ast);
-	Rematerialiser::run(*_dialect, ast);
-	UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-	ExpressionJoiner::run(ast);
-	UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
-	ExpressionJoiner::run(ast);
-	UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
+	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
+
+	Block ast = boost::get<Block>(Disambiguator(*_dialect, _analysisInfo, reservedIdentifiers)(_ast));
 
-	SSAReverser::run(ast);
-	CommonSubexpressionEliminator{*_dialect}(ast);
-	UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
+	// The FullInliner and the EquivalentFunctionCombiner require all functions to be at the
+	// top level, so they are hoisted before any of the given steps. No step moves them back.
+	runStep("yul/FunctionHoister", [&]() { FunctionHoister{}(ast); });
 
-	ExpressionJoiner::run(ast);
-	Rematerialiser::run(*_dialect, ast);
-	UnusedPruner::runUntilStabilised(*_dialect, ast, reservedIdentifiers);
+	StepContext context(*_dialect, ast, reservedIdentifiers);
+	context.separateFunctions = _separateFunctions;
+	context.jobs = _jobs;
+	runSteps(context, _steps.begin(), _steps.end());
 
 	// This is a tuning parameter, but actually just prevents infinite loops.
 	size_t stackCompressorMaxIterations = 16;
-	FunctionGrouper{}(ast);
+	runStep("yul/FunctionGrouper", [&]() { FunctionGrouper{}(ast); });
 	// We ignore the return value because we will get a much better error
 	// message once we perform code generation.
-	StackCompressor::run(_dialect, ast, _optimizeStackAllocation, stackCompressorMaxIterations);
-	BlockFlattener{}(ast);
-	DeadCodeEliminator{}(ast);
+	runStep("yul/StackCompressor", [&]() { StackCompressor::run(_dialect, ast, _optimizeStackAllocation, stackCompressorMaxIterations); });
+	runStep("yul/BlockFlattener", [&]() { BlockFlattener{}(ast); });
+	runStep("yul/DeadCodeEliminator", [&]() { DeadCodeEliminator{}(ast); });
 
-	FunctionGrouper{}(ast);
-	VarNameCleaner{ast, *_dialect, reservedIdentifiers}(ast);
+	runStep("yul/FunctionGrouper", [&]() { FunctionGrouper{}(ast); });
+	runStep("yul/VarNameCleaner", [&]() { VarNameCleaner{ast, *_dialect, reservedIdentifiers}(ast); });
 	yul::AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, ast);
 
 	_ast = std::move(ast);
 }
+
+void OptimiserSuite::validateSteps(string const& _steps)
+{
+	bool insideGroup = false;
+	for (char c: _steps)
+		if (c == '[')
+		{
+			if (insideGroup)
+				BOOST_THROW_EXCEPTION(OptimizerException() << errinfo_comment("Nested brackets are not supported in optimizer step sequences."));
+			insideGroup = true;
+		}
+		else if (c == ']')
+		{
+			if (!insideGroup)
+				BOOST_THROW_EXCEPTION(OptimizerException() << errinfo_comment("Unbalanced brackets in optimizer step sequence."));
+			insideGroup = false;
+		}
+		else if (!isspace(static_cast<unsigned char>(c)) && !findStep(c))
+			BOOST_THROW_EXCEPTION(OptimizerException() << errinfo_comment(
+				"'" + string(1, c) + "' is not a valid optimizer step abbreviation."
+			));
+	if (insideGroup)
+		BOOST_THROW_EXCEPTION(OptimizerException() << errinfo_comment("Unbalanced brackets in optimizer step sequence."));
+}
+
+map<char, string> const& OptimiserSuite::stepAbbreviations()
+{
+	static map<char, string> const abbreviations = []() {
+		map<char, string> result;
+		for (Step const& step: steps)
+			result[step.abbreviation] = string(step.phase).substr(4);
+		return result;
+	}();
+	return abbreviations;
+}
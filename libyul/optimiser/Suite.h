@@ -24,7 +24,9 @@
 #include <libyul/YulString.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <map>
 #include <set>
+#include <string>
 
 namespace yul
 {
@@ -34,17 +36,47 @@ struct Dialect;
 
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics
+ *
+ * The steps to run are given as a sequence of step abbreviations (see stepAbbreviations()).
+ * Steps enclosed in square brackets are repeated until a round does not change anything
+ * apart from variable names, but at most maxRounds times. Whitespace is ignored.
+ * Brackets cannot be nested.
+ * Steps are skipped for the whole code or, once it is grouped by the FunctionGrouper, for
+ * the main block and individual functions if they did not change the same code before.
+ * The Disambiguator and the FunctionHoister always run first, so that any order of steps
+ * is valid, and the steps that prepare the code for code generation (including the
+ * StackCompressor and the VarNameCleaner) always run last.
+ *
+ * If functions are optimised separately, consecutive function-local steps are applied to the
+ * main block and each function on their own, up to a given number of them concurrently,
+ * whenever the code is grouped by the FunctionGrouper. The result does not depend on the
+ * number of jobs, but can differ from the one without this option, e.g. in variable names.
  */
 class OptimiserSuite
 {
 public:
+	/// The step sequence that is used if no other one is specified.
+	static char const* const DefaultSteps;
+	/// Maximal number of rounds of a repeated group of steps.
+	static size_t constexpr maxRounds = 12;
+
 	static void run(
 		std::shared_ptr<Dialect> const& _dialect,
 		Block& _ast,
 		AsmAnalysisInfo const& _analysisInfo,
 		bool _optimizeStackAllocation,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		std::string const& _steps = DefaultSteps,
+		bool _separateFunctions = false,
+		unsigned _jobs = 1
 	);
+
+	/// Checks that @a _steps is a valid step sequence.
+	/// @throws OptimizerException with a description of the problem otherwise.
+	static void validateSteps(std::string const& _steps);
+
+	/// @returns the names of the steps that can be used in step sequences by their abbreviation.
+	static std::map<char, std::string> const& stepAbbreviations();
 };
 
 }
@@ -35,7 +35,7 @@ using namespace yul;
 UnusedPruner::UnusedPruner(Dialect const& _dialect, Block& _ast, set<YulString> const& _externallyUsedFunctions):
 	m_dialect(_dialect)
 {
-	m_references = ReferencesCounter::countReferences(_ast);
+	m_references = YulStringMap<size_t>(ReferencesCounter::countReferences(_ast));
 	for (auto const& f: _externallyUsedFunctions)
 		++m_references[f];
 }
@@ -43,7 +43,7 @@ UnusedPruner::UnusedPruner(Dialect const& _dialect, Block& _ast, set<YulString>
 UnusedPruner::UnusedPruner(Dialect const& _dialect, FunctionDefinition& _function, set<YulString> const& _externallyUsedFunctions):
 	m_dialect(_dialect)
 {
-	m_references = ReferencesCounter::countReferences(_function);
+	m_references = YulStringMap<size_t>(ReferencesCounter::countReferences(_function));
 	for (auto const& f: _externallyUsedFunctions)
 		++m_references[f];
 }
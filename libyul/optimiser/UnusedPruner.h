@@ -22,6 +22,7 @@
 
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/YulString.h>
+#include <libyul/YulStringMap.h>
 
 #include <map>
 #include <set>
@@ -79,7 +80,7 @@ private:
 
 	Dialect const& m_dialect;
 	bool m_shouldRunAgain = false;
-	std::map<YulString, size_t> m_references;
+	YulStringMap<size_t> m_references;
 };
 
 }
@@ -35,6 +35,8 @@
 #include <libsolidity/interface/GasEstimator.h>
 
 #include <libyul/AssemblyStack.h>
+#include <libyul/Exceptions.h>
+#include <libyul/optimiser/Suite.h>
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/GasMeter.h>
@@ -48,6 +50,7 @@
 #include <libdevcore/CommonData.h>
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/ThreadPool.h>
 
 #include <memory>
 
@@ -66,6 +69,7 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <iomanip>
 
 #if !defined(STDERR_FILENO)
 	#define STDERR_FILENO 2
@@ -108,6 +112,8 @@ static string const g_strAst = "ast";
 static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
 static string const g_strBinary = "bin";
+static string const g_strCacheDir = "cache-dir";
+static string const g_strCacheSize = "cache-size";
 static string const g_strBinaryRuntime = "bin-runtime";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strCompactJSON = "compact-format";
@@ -120,6 +126,7 @@ static string const g_strGas = "gas";
 static string const g_strHelp = "help";
 static string const g_strInputFile = "input-file";
 static string const g_strInterface = "interface";
+static string const g_strJobs = "jobs";
 static string const g_strYul = "yul";
 static string const g_strIR = "ir";
 static string const g_strLicense = "license";
@@ -134,8 +141,13 @@ static string const g_strOpcodes = "opcodes";
 static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
+static string const g_strYulOptimizations = "yul-optimizations";
+static string const g_strYulSeparateFunctions = "yul-separate-functions";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
+static string const g_strProfile = "profile";
+static string const g_strProfileTrace = "profile-trace";
+static string const g_strServer = "server";
 static string const g_strSignatureHashes = "hashes";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
@@ -160,12 +172,15 @@ static string const g_argAst = g_strAst;
 static string const g_argAstCompactJson = g_strAstCompactJson;
 static string const g_argAstJson = g_strAstJson;
 static string const g_argBinary = g_strBinary;
+static string const g_argCacheDir = g_strCacheDir;
+static string const g_argCacheSize = g_strCacheSize;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
 static string const g_argCombinedJson = g_strCombinedJson;
 static string const g_argCompactJSON = g_strCompactJSON;
 static string const g_argGas = g_strGas;
 static string const g_argHelp = g_strHelp;
 static string const g_argInputFile = g_strInputFile;
+static string const g_argJobs = g_strJobs;
 static string const g_argYul = g_strYul;
 static string const g_argIR = g_strIR;
 static string const g_argLibraries = g_strLibraries;
@@ -179,6 +194,9 @@ static string const g_argOpcodes = g_strOpcodes;
 static string const g_argOptimize = g_strOptimize;
 static string const g_argOptimizeRuns = g_strOptimizeRuns;
 static string const g_argOutputDir = g_strOutputDir;
+static string const g_argProfile = g_strProfile;
+static string const g_argProfileTrace = g_strProfileTrace;
+static string const g_argServer = g_strServer;
 static string const g_argSignatureHashes = g_strSignatureHashes;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argStrictAssembly = g_strStrictAssembly;
@@ -633,6 +651,42 @@ Allowed options)",
 			"Lower values will optimize more for initial deployment cost, higher values will optimize more for high-frequency usage."
 		)
 		(g_strOptimizeYul.c_str(), "Enable Yul optimizer in Solidity, mostly for ABIEncoderV2. Still considered experimental.")
+		(
+			g_strYulOptimizations.c_str(),
+			po::value<string>()->value_name("steps"),
+			"Use the given sequence of Yul optimizer steps instead of the default one. "
+			"Each step is given by its abbreviation, steps in square brackets are repeated "
+			"until the code does not change anymore. Requires the Yul optimizer."
+		)
+		(
+			g_strYulSeparateFunctions.c_str(),
+			"Apply the function-local steps of the Yul optimizer to each function separately, "
+			"up to --jobs of them concurrently. Can change the output, but the output does not "
+			"depend on the number of jobs. Requires the Yul optimizer."
+		)
+		(
+			(g_argJobs + ",j").c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Compile up to n contracts concurrently. Use 0 for one job per hardware thread. "
+			"Does not influence the output."
+		)
+		(
+			g_argCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Store compiled contracts in the given directory and reuse them in later invocations "
+			"with the same sources and settings. Not used together with --gas."
+		)
+		(
+			g_argCacheSize.c_str(),
+			po::value<unsigned>()->value_name("MiB")->default_value(CompilationCache::defaultMaxSize / (1024 * 1024)),
+			"Maximum size of the directory given by --cache-dir. The least recently used contracts are removed first."
+		)
+		(g_argProfile.c_str(), "Print the time and memory used by the phases of the compiler to stderr.")
+		(
+			g_argProfileTrace.c_str(),
+			po::value<string>()->value_name("file"),
+			"Write the phases of the compiler to the given file in the trace event format of chrome://tracing."
+		)
 		(g_argPrettyJson.c_str(), "Output JSON in pretty format. Currently it only works with the combined JSON output.")
 		(
 			g_argLibraries.c_str(),
@@ -658,6 +712,12 @@ Allowed options)",
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input and provides the result on the standard output."
 		)
+		(
+			g_argServer.c_str(),
+			"Switch to compiler server mode, ignoring all options except --allow-paths, --cache-dir and --cache-size. "
+			"It reads Standard JSON inputs from standard input, one per line, and writes every output as a single "
+			"line to standard output. The results of the last compilation are reused if only the requested outputs change."
+		)
 		(
 			g_argAssemble.c_str(),
 			"Switch to assembly mode, ignoring all options except --machine and --optimize and assumes input is assembly."
@@ -800,9 +860,7 @@ bool CommandLineInterface::processInput()
 			if (!boost::filesystem::is_regular_file(canonicalPath))
 				return ReadCallback::Result{false, "Not a valid file."};
 
-			auto contents = dev::readFileAsString(canonicalPath.string());
-			m_sourceCodes[path.generic_string()] = contents;
-			return ReadCallback::Result{true, contents};
+			return ReadCallback::Result{true, dev::readFileAsString(canonicalPath.string())};
 		}
 		catch (Exception const& _exception)
 		{
@@ -830,11 +888,46 @@ bool CommandLineInterface::processInput()
 		}
 	}
 
+	shared_ptr<CompilationCache> compilationCache;
+	if (m_args.count(g_argCacheDir))
+	{
+		try
+		{
+			compilationCache = make_shared<CompilationCache>(
+				m_args[g_argCacheDir].as<string>(),
+				uint64_t(m_args[g_argCacheSize].as<unsigned>()) * 1024 * 1024
+			);
+		}
+		catch (boost::filesystem::filesystem_error const& _exception)
+		{
+			serr() << "Could not create cache directory: " << _exception.what() << endl;
+			return false;
+		}
+	}
+
 	if (m_args.count(g_argStandardJSON))
 	{
 		string input = dev::readStandardInput();
 		StandardCompiler compiler(fileReader);
-		sout() << compiler.compile(input) << endl;
+		compiler.setCompilationCache(compilationCache);
+		compiler.compile(input, sout());
+		sout() << endl;
+		return true;
+	}
+
+	if (m_args.count(g_argServer))
+	{
+		StandardCompiler compiler(fileReader);
+		compiler.setCompilationCache(compilationCache);
+		compiler.setRetainCompilerStack(true);
+		string input;
+		while (getline(cin, input))
+			if (!boost::trim_copy(input).empty())
+			{
+				compiler.compile(input, sout());
+				// endl flushes, which clients waiting for the response rely on.
+				sout() << endl;
+			}
 		return true;
 	}
 
@@ -858,6 +951,19 @@ bool CommandLineInterface::processInput()
 		m_evmVersion = *versionOption;
 	}
 
+	if (m_args.count(g_strYulOptimizations))
+	{
+		try
+		{
+			yul::OptimiserSuite::validateSteps(m_args[g_strYulOptimizations].as<string>());
+		}
+		catch (yul::OptimizerException const& _exception)
+		{
+			serr() << "Invalid option for --" << g_strYulOptimizations << ": " << _exception.what() << endl;
+			return false;
+		}
+	}
+
 	if (m_args.count(g_argAssemble) || m_args.count(g_argStrictAssembly) || m_args.count(g_argYul))
 	{
 		// switch to assembly mode
@@ -891,6 +997,12 @@ bool CommandLineInterface::processInput()
 				endl;
 			return false;
 		}
+		for (string const& option: {g_strYulOptimizations, g_strYulSeparateFunctions})
+			if (!optimize && m_args.count(option))
+			{
+				serr() << "--" << option << " requires the optimizer. Use --" << g_argOptimize << "." << endl;
+				return false;
+			}
 		serr() <<
 			"Warning: Yul and its optimizer are still experimental. Please use the output with care." <<
 			endl;
@@ -904,6 +1016,12 @@ bool CommandLineInterface::processInput()
 		return link();
 	}
 
+	if (m_args.count(g_argProfile) || m_args.count(g_argProfileTrace))
+	{
+		m_profiler = make_unique<Profiler>();
+		m_profiler->activate();
+	}
+
 	m_compiler.reset(new CompilerStack(fileReader));
 
 	unique_ptr<SourceReferenceFormatter> formatter;
@@ -918,7 +1036,8 @@ bool CommandLineInterface::processInput()
 			m_compiler->useMetadataLiteralSources(true);
 		if (m_args.count(g_argInputFile))
 			m_compiler->setRemappings(m_remappings);
-		m_compiler->setSources(m_sourceCodes);
+		m_compiler->setSources(std::move(m_sourceCodes));
+		m_sourceCodes.clear();
 		if (m_args.count(g_argLibraries))
 			m_compiler->setLibraries(m_libraries);
 		m_compiler->setEVMVersion(m_evmVersion);
@@ -930,7 +1049,19 @@ bool CommandLineInterface::processInput()
 		settings.expectedExecutionsPerDeployment = m_args[g_argOptimizeRuns].as<unsigned>();
 		settings.runYulOptimiser = m_args.count(g_strOptimizeYul);
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
+		for (string const& option: {g_strYulOptimizations, g_strYulSeparateFunctions})
+			if (!settings.runYulOptimiser && m_args.count(option))
+			{
+				serr() << "--" << option << " requires the Yul optimizer. Use --" << g_strOptimizeYul << "." << endl;
+				return false;
+			}
+		if (m_args.count(g_strYulOptimizations))
+			settings.yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
+		settings.optimizeFunctionsSeparately = m_args.count(g_strYulSeparateFunctions);
 		m_compiler->setOptimiserSettings(settings);
+		m_compiler->setParallelism(m_args[g_argJobs].as<unsigned>());
+		if (!m_args.count(g_argGas))
+			m_compiler->setCompilationCache(compilationCache);
 
 		bool successful = m_compiler->compile();
 
@@ -1022,7 +1153,7 @@ void CommandLineInterface::handleCombinedJSON()
 		if (requests.count(g_strOpcodes))
 			contractData[g_strOpcodes] = dev::eth::disassemble(m_compiler->object(contractName).bytecode);
 		if (requests.count(g_strAsm))
-			contractData[g_strAsm] = m_compiler->assemblyJSON(contractName, m_sourceCodes);
+			contractData[g_strAsm] = m_compiler->assemblyJSON(contractName);
 		if (requests.count(g_strSrcMap))
 		{
 			auto map = m_compiler->sourceMapping(contractName);
@@ -1055,11 +1186,11 @@ void CommandLineInterface::handleCombinedJSON()
 	{
 		bool legacyFormat = !requests.count(g_strCompactJSON);
 		output[g_strSources] = Json::Value(Json::objectValue);
-		for (auto const& sourceCode: m_sourceCodes)
+		for (auto const& sourceName: m_compiler->sourceNames())
 		{
 			ASTJsonConverter converter(legacyFormat, m_compiler->sourceIndices());
-			output[g_strSources][sourceCode.first] = Json::Value(Json::objectValue);
-			output[g_strSources][sourceCode.first]["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
+			output[g_strSources][sourceName] = Json::Value(Json::objectValue);
+			output[g_strSources][sourceName]["AST"] = converter.toJson(m_compiler->ast(sourceName));
 		}
 	}
 
@@ -1088,8 +1219,8 @@ void CommandLineInterface::handleAst(string const& _argStr)
 	if (m_args.count(_argStr))
 	{
 		vector<ASTNode const*> asts;
-		for (auto const& sourceCode: m_sourceCodes)
-			asts.push_back(&m_compiler->ast(sourceCode.first));
+		for (auto const& sourceName: m_compiler->sourceNames())
+			asts.push_back(&m_compiler->ast(sourceName));
 		map<ASTNode const*, eth::GasMeter::GasConsumption> gasCosts;
 		for (auto const& contract : m_compiler->contractNames())
 		{
@@ -1108,41 +1239,41 @@ void CommandLineInterface::handleAst(string const& _argStr)
 		bool legacyFormat = !m_args.count(g_argAstCompactJson);
 		if (m_args.count(g_argOutputDir))
 		{
-			for (auto const& sourceCode: m_sourceCodes)
+			for (auto const& sourceName: m_compiler->sourceNames())
 			{
 				stringstream data;
 				string postfix = "";
 				if (_argStr == g_argAst)
 				{
-					ASTPrinter printer(m_compiler->ast(sourceCode.first), sourceCode.second);
+					ASTPrinter printer(m_compiler->ast(sourceName), m_compiler->scanner(sourceName).source());
 					printer.print(data);
 				}
 				else
 				{
-					ASTJsonConverter(legacyFormat, m_compiler->sourceIndices()).print(data, m_compiler->ast(sourceCode.first));
+					ASTJsonConverter(legacyFormat, m_compiler->sourceIndices()).print(data, m_compiler->ast(sourceName));
 					postfix += "_json";
 				}
-				boost::filesystem::path path(sourceCode.first);
+				boost::filesystem::path path(sourceName);
 				createFile(path.filename().string() + postfix + ".ast", data.str());
 			}
 		}
 		else
 		{
 			sout() << title << endl << endl;
-			for (auto const& sourceCode: m_sourceCodes)
+			for (auto const& sourceName: m_compiler->sourceNames())
 			{
-				sout() << endl << "======= " << sourceCode.first << " =======" << endl;
+				sout() << endl << "======= " << sourceName << " =======" << endl;
 				if (_argStr == g_argAst)
 				{
 					ASTPrinter printer(
-						m_compiler->ast(sourceCode.first),
-						sourceCode.second,
+						m_compiler->ast(sourceName),
+						m_compiler->scanner(sourceName).source(),
 						gasCosts
 					);
 					printer.print(sout());
 				}
 				else
-					ASTJsonConverter(legacyFormat, m_compiler->sourceIndices()).print(sout(), m_compiler->ast(sourceCode.first));
+					ASTJsonConverter(legacyFormat, m_compiler->sourceIndices()).print(sout(), m_compiler->ast(sourceName));
 			}
 		}
 	}
@@ -1150,16 +1281,49 @@ void CommandLineInterface::handleAst(string const& _argStr)
 
 bool CommandLineInterface::actOnInput()
 {
-	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
+	if (m_args.count(g_argStandardJSON) || m_args.count(g_argServer) || m_onlyAssemble)
 		// Already done in "processInput" phase.
 		return true;
 	else if (m_onlyLink)
 		writeLinkedFiles();
 	else
 		outputCompilationResults();
+	if (m_profiler)
+		outputProfile();
 	return !m_error;
 }
 
+void CommandLineInterface::outputProfile()
+{
+	m_profiler->deactivate();
+
+	if (m_args.count(g_argProfile))
+	{
+		serr() << endl << "======= Profile =======" << endl;
+		serr() << left << setw(40) << "Phase" << setw(30) << "Context" << right << setw(8) << "Calls";
+		serr() << setw(12) << "Time (ms)" << setw(14) << "Memory (KiB)" << endl;
+		for (Json::Value const& entry: m_profiler->summary())
+		{
+			serr() << left << setw(40) << entry["phase"].asString() << setw(30) << entry["context"].asString();
+			serr() << right << setw(8) << entry["calls"].asUInt();
+			serr() << setw(12) << fixed << setprecision(3) << double(entry["time"].asUInt64()) / 1000;
+			serr() << setw(14) << entry["memory"].asUInt64() / 1024 << endl;
+		}
+	}
+
+	if (m_args.count(g_argProfileTrace))
+	{
+		string pathName = m_args[g_argProfileTrace].as<string>();
+		ofstream outFile(pathName);
+		outFile << jsonCompactPrint(m_profiler->chromeTrace());
+		if (!outFile)
+		{
+			serr() << "Could not write to file: " << pathName << endl;
+			m_error = true;
+		}
+	}
+}
+
 bool CommandLineInterface::link()
 {
 	// Map from how the libraries will be named inside the bytecode to their addresses.
@@ -1255,14 +1419,17 @@ bool CommandLineInterface::assemble(
 )
 {
 	bool successful = true;
+	unsigned jobs = m_args[g_argJobs].as<unsigned>();
+	if (jobs == 0)
+		jobs = ThreadPool::hardwareConcurrency();
 	map<string, yul::AssemblyStack> assemblyStacks;
 	for (auto const& src: m_sourceCodes)
 	{
-		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(
-			m_evmVersion,
-			_language,
-			_optimize ? OptimiserSettings::full() : OptimiserSettings::minimal()
-		);
+		OptimiserSettings settings = _optimize ? OptimiserSettings::full() : OptimiserSettings::minimal();
+		if (m_args.count(g_strYulOptimizations))
+			settings.yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
+		settings.optimizeFunctionsSeparately = m_args.count(g_strYulSeparateFunctions);
+		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(m_evmVersion, _language, settings, jobs);
 		try
 		{
 			if (!stack.parseAndAnalyze(src.first, src.second))
@@ -1370,9 +1537,9 @@ void CommandLineInterface::outputCompilationResults()
 		{
 			string ret;
 			if (m_args.count(g_argAsmJson))
-				ret = dev::jsonPrettyPrint(m_compiler->assemblyJSON(contract, m_sourceCodes));
+				ret = dev::jsonPrettyPrint(m_compiler->assemblyJSON(contract));
 			else
-				ret = m_compiler->assemblyString(contract, m_sourceCodes);
+				ret = m_compiler->assemblyString(contract);
 
 			if (m_args.count(g_argOutputDir))
 			{
@@ -23,6 +23,7 @@
 
 #include <libsolidity/interface/CompilerStack.h>
 #include <libyul/AssemblyStack.h>
+#include <libdevcore/Profiler.h>
 #include <liblangutil/EVMVersion.h>
 
 #include <boost/program_options.hpp>
@@ -60,6 +61,8 @@ private:
 	bool assemble(yul::AssemblyStack::Language _language, yul::AssemblyStack::Machine _targetMachine, bool _optimize);
 
 	void outputCompilationResults();
+	/// Prints and writes the profile requested by --profile and --profile-trace.
+	void outputProfile();
 
 	void handleCombinedJSON();
 	void handleAst(std::string const& _argStr);
@@ -98,7 +101,7 @@ private:
 
 	/// Compiler arguments variable map
 	boost::program_options::variables_map m_args;
-	/// map of input files to source code strings
+	/// map of input files to source code strings, moved into the compiler stack when compiling
 	std::map<std::string, std::string> m_sourceCodes;
 	/// list of remappings
 	std::vector<dev::solidity::CompilerStack::Remapping> m_remappings;
@@ -108,6 +111,8 @@ private:
 	std::map<std::string, h160> m_libraries;
 	/// Solidity compiler stack
 	std::unique_ptr<dev::solidity::CompilerStack> m_compiler;
+	/// Profiler of the compilation, only set if requested
+	std::unique_ptr<dev::Profiler> m_profiler;
 	/// EVM version to use
 	langutil::EVMVersion m_evmVersion;
 	/// Whether or not to colorize diagnostics output.
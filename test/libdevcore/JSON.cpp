@@ -23,6 +23,8 @@
 
 #include <test/Options.h>
 
+#include <sstream>
+
 using namespace std;
 
 namespace dev
@@ -69,6 +71,36 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK("{\"1\":1,\"2\":\"2\",\"3\":{\"3.1\":\"3.1\",\"3.2\":2}}" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_stream_writer)
+{
+	Json::Value json;
+	json["a"]["b"] = 1;
+	json["a"]["c"]["d"] = "x\"y";
+	json["a"]["c"]["e"] = Json::arrayValue;
+	json["b"] = Json::objectValue;
+	json["c\n"]["f"] = true;
+
+	ostringstream stream;
+	JsonStreamWriter writer(stream);
+	writer.write({"a", "b"}, 1);
+	writer.write({"a", "c", "d"}, "x\"y");
+	writer.writeSerialized({"a", "c", "e"}, "[]");
+	BOOST_CHECK(!writer.canWrite({"a", "c"}));
+	BOOST_CHECK(!writer.canWrite({"a", "c", "e", "f"}));
+	BOOST_CHECK(!writer.canWrite({"a", "b", "c"}));
+	BOOST_CHECK(writer.canWrite({"a", "d"}));
+	writer.write({"b"}, Json::objectValue);
+	writer.write({"c\n", "f"}, true);
+	BOOST_CHECK_THROW(writer.write({"b", "x"}, 1), JsonStreamWriterError);
+	writer.finish();
+	BOOST_CHECK_EQUAL(stream.str(), jsonCompactPrint(json));
+
+	ostringstream emptyStream;
+	JsonStreamWriter emptyWriter(emptyStream);
+	emptyWriter.finish();
+	BOOST_CHECK_EQUAL(emptyStream.str(), jsonCompactPrint(Json::Value(Json::objectValue)));
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_not_strict)
 {
 	Json::Value json;
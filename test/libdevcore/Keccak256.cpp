@@ -0,0 +1,78 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the Keccak-256 hash function.
+ */
+
+#include <libdevcore/Keccak256.h>
+
+#include <test/Options.h>
+
+#include <random>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(Keccak256)
+
+BOOST_AUTO_TEST_CASE(known_hashes)
+{
+	BOOST_CHECK_EQUAL(keccak256(string()).hex(), "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+	BOOST_CHECK_EQUAL(keccak256(string("abc")).hex(), "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45");
+	BOOST_CHECK_EQUAL(
+		keccak256(string("transfer(address,uint256)")).hex(),
+		"a9059cbb2ab09eb219583f4a59a5d0623ade346d962bcd4e46b11da047c9049b"
+	);
+	// Around the block size of 136 bytes.
+	BOOST_CHECK_EQUAL(keccak256(string(135, 'a')).hex(), "34367dc248bbd832f4e3e69dfaac2f92638bd0bbd18f2912ba4ef454919cf446");
+	BOOST_CHECK_EQUAL(keccak256(string(136, 'a')).hex(), "a6c4d403279fe3e0af03729caada8374b5ca54d8065329a3ebcaeb4b60aa386e");
+	BOOST_CHECK_EQUAL(keccak256(string(137, 'a')).hex(), "d869f639c7046b4929fc92a4d988a8b22c55fbadb802c0c66ebcd484f1915f39");
+	BOOST_CHECK_EQUAL(keccak256(string(1000, 'b')).hex(), "70cd71701ef057f124b9f04c2204cea92c2ec7d250ad4183b9953e4b78fb5c33");
+}
+
+BOOST_AUTO_TEST_CASE(multiple_inputs)
+{
+	BOOST_CHECK(keccak256(vector<bytesConstRef>()).empty());
+
+	mt19937 random(42);
+	vector<bytes> inputs;
+	for (size_t i = 0; i < 100; ++i)
+	{
+		// Mostly short inputs, some of them longer than a block.
+		bytes input(i % 5 == 0 ? random() % 500 : random() % 40);
+		for (auto& byte: input)
+			byte = uint8_t(random());
+		inputs.push_back(move(input));
+	}
+	vector<bytesConstRef> refs;
+	for (bytes const& input: inputs)
+		refs.emplace_back(&input);
+
+	vector<h256> hashes = keccak256(refs);
+	BOOST_REQUIRE_EQUAL(hashes.size(), inputs.size());
+	for (size_t i = 0; i < inputs.size(); ++i)
+		BOOST_CHECK_EQUAL(hashes[i], keccak256(inputs[i]));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
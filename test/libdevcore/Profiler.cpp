@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the profiler.
+ */
+
+#include <libdevcore/Profiler.h>
+
+#include <test/Options.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(ProfilerTest)
+
+BOOST_AUTO_TEST_CASE(inactive)
+{
+	Profiler profiler;
+	{
+		ProfilerContext context("A");
+		ProfilerPhase phase("phase");
+	}
+	BOOST_CHECK(profiler.events().empty());
+	BOOST_CHECK(Profiler::active() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(records_nested_phases)
+{
+	Profiler profiler;
+	BOOST_REQUIRE(profiler.activate());
+	{
+		ProfilerPhase outer("outer");
+		{
+			ProfilerContext context("A");
+			ProfilerPhase inner("inner");
+		}
+		{
+			ProfilerContext context("A");
+			ProfilerPhase inner("inner");
+		}
+	}
+	profiler.deactivate();
+
+	vector<Profiler::Event> events = profiler.events();
+	BOOST_REQUIRE_EQUAL(events.size(), 3);
+	BOOST_CHECK_EQUAL(events[0].phase, "inner");
+	BOOST_CHECK_EQUAL(events[0].context, "A");
+	BOOST_CHECK_EQUAL(events[2].phase, "outer");
+	BOOST_CHECK_EQUAL(events[2].context, "");
+	BOOST_CHECK(events[2].start <= events[0].start);
+	BOOST_CHECK(events[2].duration >= events[0].duration + events[1].duration);
+
+	Json::Value summary = profiler.summary();
+	BOOST_REQUIRE_EQUAL(summary.size(), 2);
+	BOOST_CHECK_EQUAL(summary[0]["context"].asString(), "");
+	BOOST_CHECK_EQUAL(summary[0]["phase"].asString(), "outer");
+	BOOST_CHECK_EQUAL(summary[1]["context"].asString(), "A");
+	BOOST_CHECK_EQUAL(summary[1]["calls"].asUInt(), 2);
+
+	Json::Value trace = profiler.chromeTrace();
+	BOOST_CHECK_EQUAL(trace["traceEvents"].size(), 3);
+	BOOST_CHECK_EQUAL(trace["traceEvents"][0]["ph"].asString(), "X");
+}
+
+BOOST_AUTO_TEST_CASE(single_active_profiler)
+{
+	Profiler first;
+	BOOST_REQUIRE(first.activate());
+	{
+		Profiler second;
+		BOOST_CHECK(!second.activate());
+		BOOST_CHECK(Profiler::active() == &first);
+	}
+	BOOST_CHECK(Profiler::active() == &first);
+	first.deactivate();
+	BOOST_CHECK(Profiler::active() == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
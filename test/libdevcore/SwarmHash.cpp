@@ -51,6 +51,23 @@ BOOST_AUTO_TEST_CASE(test_zeros)
 	BOOST_CHECK_EQUAL(swarmHashHex(string(2095104, 0)), string("a9958184589fc11b4027a4c233e777ebe2e99c66f96b74aef2a0638a94dd5439"));
 }
 
+BOOST_AUTO_TEST_CASE(test_concurrent)
+{
+	for (size_t size: {size_t(0x1000 - 1), size_t(0x2000 + 1), size_t(0x80020), size_t(0x800020), size_t(2095104)})
+	{
+		string input(size, 0);
+		for (size_t i = 0; i < size; ++i)
+			input[i] = char(i * 7 + i / 0x1000);
+		h256 expectation = swarmHash(input);
+		for (unsigned jobs: {2u, 3u, 8u})
+			BOOST_CHECK_EQUAL(swarmHash(input, jobs), expectation);
+	}
+	BOOST_CHECK_EQUAL(
+		toHex(swarmHash(string(0x80020, 0), 4).asBytes()),
+		string("ee9ffca246e70d3704740ba4df450fa6988d14a1c2439c7e734c7a77a4eb6fd3")
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
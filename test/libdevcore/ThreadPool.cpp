@@ -0,0 +1,89 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the worker pool.
+ */
+
+#include <libdevcore/ThreadPool.h>
+#include <libdevcore/Exceptions.h>
+
+#include <test/Options.h>
+
+#include <atomic>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
+
+BOOST_AUTO_TEST_CASE(single_job_runs_in_order)
+{
+	vector<int> order;
+	ThreadPool pool(1);
+	for (int i = 0; i < 10; ++i)
+		pool.schedule([&, i]() { order.push_back(i); });
+	BOOST_CHECK(order.empty());
+	pool.wait();
+	BOOST_CHECK(order == (vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+BOOST_AUTO_TEST_CASE(runs_all_tasks)
+{
+	atomic<unsigned> sum{0};
+	ThreadPool pool(4);
+	for (unsigned i = 1; i <= 100; ++i)
+		pool.schedule([&, i]() { sum += i; });
+	pool.wait();
+	BOOST_CHECK_EQUAL(sum, 5050);
+}
+
+BOOST_AUTO_TEST_CASE(nested_scheduling)
+{
+	atomic<unsigned> count{0};
+	ThreadPool pool(3);
+	function<void(unsigned)> spawn = [&](unsigned _depth)
+	{
+		++count;
+		if (_depth > 0)
+			for (unsigned i = 0; i < 2; ++i)
+				pool.schedule([&, _depth]() { spawn(_depth - 1); });
+	};
+	pool.schedule([&]() { spawn(5); });
+	pool.wait();
+	BOOST_CHECK_EQUAL(count, 63);
+}
+
+BOOST_AUTO_TEST_CASE(exception_is_rethrown)
+{
+	ThreadPool pool(2);
+	pool.schedule([]() { BOOST_THROW_EXCEPTION(Exception() << errinfo_comment("failure")); });
+	BOOST_CHECK_THROW(pool.wait(), Exception);
+	// The pool is usable again afterwards.
+	bool executed = false;
+	pool.schedule([&]() { executed = true; });
+	pool.wait();
+	BOOST_CHECK(executed);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
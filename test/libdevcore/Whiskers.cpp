@@ -121,6 +121,37 @@ BOOST_AUTO_TEST_CASE(parameter_collision)
 	BOOST_CHECK_THROW(m.render(), WhiskersError);
 }
 
+BOOST_AUTO_TEST_CASE(unclosed_list)
+{
+	// Unmatched list tags are kept, tags inside are still replaced.
+	string templ = "a<#b><c></d>";
+	string result = Whiskers(templ)("c", "C")("b", vector<Whiskers::StringMap>{}).render();
+	BOOST_CHECK_EQUAL(result, "a<#b>C</d>");
+}
+
+BOOST_AUTO_TEST_CASE(multiline_list)
+{
+	string templ = "{\n<#b>\tx := <g>\n</b>}";
+	vector<map<string, string>> list(2);
+	list[0]["g"] = "1";
+	list[1]["g"] = "2";
+	string result = Whiskers(templ)("b", list).render();
+	BOOST_CHECK_EQUAL(result, "{\n\tx := 1\n\tx := 2\n}");
+}
+
+BOOST_AUTO_TEST_CASE(same_template)
+{
+	// The parsed template is shared, but the parameters are not.
+	string templ = "<a><#b><c></b>";
+	vector<map<string, string>> list(1);
+	list[0]["c"] = "C";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "A")("b", list).render(), "AC");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "X")("b", vector<Whiskers::StringMap>{}).render(), "X");
+	Whiskers m(templ);
+	m("b", list);
+	BOOST_CHECK_THROW(m.render(), WhiskersError);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,124 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Tests for the storage of the data of assembly items.
+ */
+
+#include <libevmasm/AssemblyItem.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+
+using namespace std;
+using namespace dev::eth;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+	u256 const maxSmall = numeric_limits<uint64_t>::max();
+	// Not used by any other test, so that the number of values in use can be checked.
+	u256 const uniqueLarge("0x7d1a3e0b9c2f48d65e31a07f4c9b2d8e61f05a3c7b4e29d80f6c1a5e3b7d92c4");
+}
+
+BOOST_AUTO_TEST_SUITE(AssemblyItems)
+
+BOOST_AUTO_TEST_CASE(data_round_trip)
+{
+	for (u256 const& value: {u256(0), u256(1), maxSmall, maxSmall + 1, u256(1) << 128, ~u256(0)})
+	{
+		AssemblyItem item(value);
+		BOOST_CHECK(item.type() == Push);
+		BOOST_CHECK_EQUAL(item.data(), value);
+		AssemblyItem copy = item;
+		BOOST_CHECK_EQUAL(copy.data(), value);
+	}
+
+	AssemblyItem item(PushTag, 7);
+	item.setData(~u256(0));
+	BOOST_CHECK_EQUAL(item.data(), ~u256(0));
+	item.setData(7);
+	BOOST_CHECK_EQUAL(item.data(), 7);
+	BOOST_CHECK(item == AssemblyItem(PushTag, 7));
+}
+
+BOOST_AUTO_TEST_CASE(large_values_are_interned)
+{
+	size_t const valuesInUse = AssemblyItem::largeValuesInUse();
+	{
+		AssemblyItem a(uniqueLarge);
+		AssemblyItem b(uniqueLarge);
+		AssemblyItem c(uniqueLarge + 1);
+		BOOST_CHECK(a == b);
+		BOOST_CHECK(!(a < b) && !(b < a));
+		BOOST_CHECK(a != c);
+		BOOST_CHECK(a < c);
+		BOOST_CHECK_EQUAL(AssemblyItem::largeValuesInUse(), valuesInUse + 2);
+
+		AssemblyItem copy = a;
+		BOOST_CHECK_EQUAL(AssemblyItem::largeValuesInUse(), valuesInUse + 2);
+		c.setData(1);
+		BOOST_CHECK_EQUAL(AssemblyItem::largeValuesInUse(), valuesInUse + 1);
+	}
+	// Values are dropped once no item uses them anymore.
+	BOOST_CHECK_EQUAL(AssemblyItem::largeValuesInUse(), valuesInUse);
+	AssemblyItem again(uniqueLarge);
+	BOOST_CHECK_EQUAL(again.data(), uniqueLarge);
+	BOOST_CHECK_EQUAL(AssemblyItem::largeValuesInUse(), valuesInUse + 1);
+}
+
+BOOST_AUTO_TEST_CASE(pushed_value)
+{
+	AssemblyItem item(PushSubSize, 3);
+	BOOST_CHECK(!item.pushedValue());
+	item.setPushedValue(1234);
+	BOOST_REQUIRE(item.pushedValue());
+	BOOST_CHECK_EQUAL(*item.pushedValue(), 1234);
+	AssemblyItem copy = item;
+	BOOST_REQUIRE(copy.pushedValue());
+	BOOST_CHECK_EQUAL(*copy.pushedValue(), 1234);
+	// The pushed value is not part of the data.
+	BOOST_CHECK_EQUAL(item.data(), 3);
+	BOOST_CHECK(item == AssemblyItem(PushSubSize, 3));
+}
+
+BOOST_AUTO_TEST_CASE(comparison_across_64_bit_boundary)
+{
+	vector<u256> values{0, 1, maxSmall - 1, maxSmall, maxSmall + 1, maxSmall + 2, u256(1) << 200, ~u256(0)};
+	for (size_t i = 0; i < values.size(); ++i)
+		for (size_t j = 0; j < values.size(); ++j)
+		{
+			AssemblyItem a(values[i]);
+			AssemblyItem b(values[j]);
+			BOOST_CHECK_EQUAL(a == b, i == j);
+			BOOST_CHECK_EQUAL(a < b, i < j);
+		}
+	// Items of different types are ordered by type first.
+	BOOST_CHECK(AssemblyItem(Push, ~u256(0)) < AssemblyItem(PushTag, 0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+} // end namespaces
@@ -1158,6 +1158,94 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(parallel_subassembly_optimisation)
+{
+	// Optimising sub-assemblies concurrently has to give the same result as optimising
+	// them sequentially, also if a sub-assembly is shared between several others.
+	auto createAssembly = []()
+	{
+		auto createSub = []()
+		{
+			AssemblyPointer sub = make_shared<Assembly>();
+			auto t1 = sub->newTag();
+			sub->append(t1);
+			sub->append(u256(2));
+			sub->append(Instruction::JUMP);
+			auto t2 = sub->newTag();
+			sub->append(t2); // Identical to T1, will be unified
+			sub->append(u256(2));
+			sub->append(Instruction::JUMP);
+			sub->append(u256(7));
+			sub->append(u256(8));
+			sub->append(Instruction::ADD);
+			return make_pair(sub, t2);
+		};
+		auto shared = createSub();
+		auto main = make_shared<Assembly>();
+		for (size_t i = 0; i < 6; ++i)
+		{
+			auto sub = createSub();
+			if (i % 2 == 0)
+				sub.first->appendSubroutine(shared.first);
+			size_t subId = size_t(main->appendSubroutine(sub.first).data());
+			main->append(sub.second.toSubAssemblyTag(subId).pushTag());
+		}
+		main->appendSubroutine(shared.first);
+		return main;
+	};
+
+	auto sequential = createAssembly();
+	auto parallel = createAssembly();
+	Assembly::OptimiserSettings settings;
+	settings.isCreation = true;
+	settings.runJumpdestRemover = true;
+	settings.runPeephole = true;
+	settings.runDeduplicate = true;
+	settings.runCSE = true;
+	settings.evmVersion = dev::test::Options::get().evmVersion();
+	sequential->optimise(settings);
+	settings.jobs = 4;
+	parallel->optimise(settings);
+
+	BOOST_CHECK_EQUAL(parallel->assemblyString(), sequential->assemblyString());
+	BOOST_CHECK(parallel->assemble().bytecode == sequential->assemble().bytecode);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_cse)
+{
+	// Large enough to be split into several tasks.
+	auto createAssembly = []()
+	{
+		auto main = make_shared<Assembly>();
+		for (unsigned i = 0; i < 1000; ++i)
+		{
+			main->append(main->newTag());
+			main->append(u256(i));
+			main->append(u256(2));
+			main->append(Instruction::ADD);
+			main->append(u256(3));
+			main->append(Instruction::MUL);
+			main->append(Instruction::DUP1);
+			main->append(Instruction::POP);
+			main->append(u256(i % 7));
+			main->append(Instruction::SSTORE);
+		}
+		return main;
+	};
+
+	auto sequential = createAssembly();
+	auto parallel = createAssembly();
+	Assembly::OptimiserSettings settings;
+	settings.runCSE = true;
+	settings.evmVersion = dev::test::Options::get().evmVersion();
+	sequential->optimise(settings);
+	settings.jobs = 4;
+	parallel->optimise(settings);
+
+	BOOST_CHECK(parallel->items().size() < createAssembly()->items().size());
+	BOOST_CHECK_EQUAL(parallel->assemblyString(), sequential->assemblyString());
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the CharStream class.
+ */
+
+#include <liblangutil/CharStream.h>
+
+#include <test/Options.h>
+
+namespace langutil
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(CharStreamTest)
+
+BOOST_AUTO_TEST_CASE(copies_share_source)
+{
+	CharStream stream("abc\ndef", "source");
+	CharStream copy = stream;
+	BOOST_CHECK(&copy.source() == &stream.source());
+	BOOST_CHECK_EQUAL(copy.advanceAndGet(), 'b');
+	BOOST_CHECK_EQUAL(stream.get(), 'a');
+
+	auto text = std::make_shared<std::string const>("xyz");
+	CharStream shared(text, "shared");
+	BOOST_CHECK(&shared.source() == text.get());
+	BOOST_CHECK(shared.sharedSource() == text);
+}
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+	CharStream stream;
+	BOOST_CHECK(stream.isPastEndOfInput());
+	BOOST_CHECK_EQUAL(stream.source(), "");
+}
+
+BOOST_AUTO_TEST_CASE(bulk_scanning)
+{
+	for (size_t offset = 0; offset < 40; offset++)
+	{
+		CharStream stream(std::string(offset, 'x') + "*\r  \tyy", "source");
+		BOOST_CHECK_EQUAL(stream.charsUntil({'*'}), offset);
+		BOOST_CHECK_EQUAL(stream.charsUntil({'a', '\r'}), offset + 1);
+		BOOST_CHECK_EQUAL(stream.charsUntil({'a'}, true), offset + 1);
+		BOOST_CHECK_EQUAL(stream.charsUntil({'a'}), offset + 7);
+		BOOST_CHECK_EQUAL(stream.charsWhile({'x'}), offset);
+		stream.advanceAndGet(offset + 1);
+		BOOST_CHECK_EQUAL(stream.charsWhile({' ', '\t', '\r', '\n'}), 4);
+		stream.advanceAndGet(6);
+		BOOST_CHECK(stream.isPastEndOfInput());
+		BOOST_CHECK_EQUAL(stream.charsUntil({'y'}), 0);
+		BOOST_CHECK_EQUAL(stream.charsWhile({'y'}), 0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(line_column)
+{
+	CharStream stream("abc\ndef", "source");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(5), "def");
+	BOOST_CHECK(stream.translatePositionToLineColumn(5) == std::make_tuple(1, 1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -18,6 +18,7 @@
 #include <test/libsolidity/ASTJSONTest.h>
 #include <test/Options.h>
 #include <libdevcore/AnsiColorized.h>
+#include <libdevcore/JSON.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <boost/algorithm/string.hpp>
@@ -169,6 +170,23 @@ bool ASTJSONTest::run(ostream& _stream, string const& _linePrefix, bool const _f
 		resultsMatch = false;
 	}
 
+	// The direct serialization has to match the one via JSON values.
+	for (auto const& source: m_sources)
+		for (bool legacy: {false, true})
+		{
+			ASTJsonConverter converter(legacy, sourceIndices);
+			string expectation = jsonCompactPrint(converter.toJson(c.ast(source.first)));
+			string result = converter.toCompactJson(c.ast(source.first));
+			if (expectation != result)
+			{
+				AnsiColorized(_stream, _formatted, {BOLD, RED}) << _linePrefix <<
+					"Direct serialization" << (legacy ? " (legacy)" : "") << " differs:" << endl;
+				_stream << _linePrefix << "  " << expectation << endl;
+				_stream << _linePrefix << "  " << result << endl;
+				resultsMatch = false;
+			}
+		}
+
 	return resultsMatch;
 }
 
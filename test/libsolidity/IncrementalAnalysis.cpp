@@ -0,0 +1,256 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * Unit tests for updating the sources of a compiler stack.
+ */
+
+#include <test/Options.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/ast/ASTJsonConverter.h>
+#include <liblangutil/Exceptions.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace langutil;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+StringMap const sources{
+	{"A", "contract A { function f() public pure returns (uint) { return 1; } }"},
+	{"B", "import \"A\"; contract B is A { function g() public pure returns (uint) { return f(); } }"},
+	{"C", "contract C { function h() public { uint x; } }"},
+	{"E", "import {C as C2} from \"C\"; contract E is C2 { function k() public view returns (address) { return address(this); } function l() public view returns (uint) { return block.number; } }"}
+};
+
+void configure(CompilerStack& _compilerStack)
+{
+	_compilerStack.setEVMVersion(dev::test::Options::get().evmVersion());
+	_compilerStack.setOptimiserSettings(dev::test::Options::get().optimize);
+}
+
+string formatErrors(CompilerStack const& _compilerStack)
+{
+	string result;
+	for (auto const& error: _compilerStack.errors())
+		result += SourceReferenceFormatter::formatExceptionInformation(
+			*error,
+			(error->type() == Error::Type::Warning) ? "Warning" : "Error"
+		);
+	return result;
+}
+
+/// Checks that @a _compilerStack produces exactly the same output (including the IDs of the
+/// AST nodes and the order of the errors) as a new compiler stack for @a _sources.
+void checkSameAsFullCompilation(CompilerStack& _compilerStack, StringMap const& _sources)
+{
+	// Node IDs are dispensed globally, so the other stack is only used after this one.
+	BOOST_REQUIRE(_compilerStack.compile());
+	CompilerStack fullCompilerStack;
+	fullCompilerStack.setSources(_sources);
+	configure(fullCompilerStack);
+	BOOST_REQUIRE(fullCompilerStack.compile());
+	BOOST_REQUIRE(_compilerStack.contractNames() == fullCompilerStack.contractNames());
+	for (string const& contractName: fullCompilerStack.contractNames())
+	{
+		BOOST_CHECK(_compilerStack.object(contractName).bytecode == fullCompilerStack.object(contractName).bytecode);
+		BOOST_CHECK(_compilerStack.runtimeObject(contractName).bytecode == fullCompilerStack.runtimeObject(contractName).bytecode);
+		BOOST_CHECK_EQUAL(_compilerStack.metadata(contractName), fullCompilerStack.metadata(contractName));
+	}
+	BOOST_REQUIRE(_compilerStack.sourceNames() == fullCompilerStack.sourceNames());
+	for (string const& sourceName: fullCompilerStack.sourceNames())
+		BOOST_CHECK_EQUAL(
+			ASTJsonConverter(false, _compilerStack.sourceIndices()).toCompactJson(_compilerStack.ast(sourceName)),
+			ASTJsonConverter(false, fullCompilerStack.sourceIndices()).toCompactJson(fullCompilerStack.ast(sourceName))
+		);
+	BOOST_CHECK_EQUAL(formatErrors(_compilerStack), formatErrors(fullCompilerStack));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(IncrementalAnalysis)
+
+BOOST_AUTO_TEST_CASE(changed_source)
+{
+	CompilerStack compilerStack;
+	compilerStack.setSources(sources);
+	configure(compilerStack);
+	BOOST_REQUIRE(compilerStack.compile());
+
+	StringMap updatedSources = sources;
+	updatedSources["A"] = "contract A { function f() public pure returns (uint) { uint y; return 2; } }";
+	BOOST_REQUIRE(compilerStack.updateSources({{"A", updatedSources["A"]}}));
+	BOOST_CHECK(compilerStack.state() == CompilerStack::ParsingSuccessful);
+	BOOST_REQUIRE(compilerStack.analyze());
+	checkSameAsFullCompilation(compilerStack, updatedSources);
+}
+
+BOOST_AUTO_TEST_CASE(changed_source_with_more_nodes_before_others)
+{
+	// Growing the first source shifts the IDs of the nodes of all other sources.
+	CompilerStack compilerStack;
+	compilerStack.setSources(sources);
+	configure(compilerStack);
+	BOOST_REQUIRE(compilerStack.compile());
+
+	StringMap updatedSources = sources;
+	updatedSources["A"] =
+		"contract A { function f() public pure returns (uint) { return 1; } }\n"
+		"contract A2 is A { function f2() public pure returns (uint) { return f() + 1; } }";
+	BOOST_REQUIRE(compilerStack.updateSources({{"A", updatedSources["A"]}}));
+	checkSameAsFullCompilation(compilerStack, updatedSources);
+}
+
+BOOST_AUTO_TEST_CASE(unchanged_sources_are_kept)
+{
+	CompilerStack compilerStack;
+	compilerStack.setSources(sources);
+	configure(compilerStack);
+	BOOST_REQUIRE(compilerStack.compile());
+	SourceUnit const* astA = &compilerStack.ast("A");
+
+	BOOST_REQUIRE(compilerStack.updateSources({{"A", sources.at("A")}}));
+	BOOST_CHECK(&compilerStack.ast("A") == astA);
+	checkSameAsFullCompilation(compilerStack, sources);
+}
+
+BOOST_AUTO_TEST_CASE(only_changed_sources_and_importers_are_parsed)
+{
+	CompilerStack compilerStack;
+	compilerStack.setSources(sources);
+	configure(compilerStack);
+	BOOST_REQUIRE(compilerStack.compile());
+	SourceUnit const* astA = &compilerStack.ast("A");
+	SourceUnit const* astB = &compilerStack.ast("B");
+	SourceUnit const* astC = &compilerStack.ast("C");
+	SourceUnit const* astE = &compilerStack.ast("E");
+
+	// The warning of the unused variable in "C" is reported again after the errors of "A".
+	StringMap updatedSources = sources;
+	updatedSources["A"] = "contract A { function f() public pure returns (uint) { uint y; return 2; } }";
+	BOOST_REQUIRE(compilerStack.updateSources({{"A", updatedSources["A"]}}));
+	BOOST_CHECK(&compilerStack.ast("A") != astA);
+	BOOST_CHECK(&compilerStack.ast("B") != astB);
+	BOOST_CHECK(&compilerStack.ast("C") == astC);
+	BOOST_CHECK(&compilerStack.ast("E") == astE);
+	checkSameAsFullCompilation(compilerStack, updatedSources);
+
+	// Changing "C" shifts the node IDs of the kept sources "A" and "B".
+	updatedSources["C"] = "contract C { function h() public { uint x; uint z; } }";
+	BOOST_REQUIRE(compilerStack.updateSources({{"C", updatedSources["C"]}}));
+	BOOST_CHECK(&compilerStack.ast("C") != astC);
+	BOOST_CHECK(&compilerStack.ast("E") != astE);
+	checkSameAsFullCompilation(compilerStack, updatedSources);
+}
+
+BOOST_AUTO_TEST_CASE(sources_loaded_via_callback)
+{
+	StringMap files{{"D", "contract D { function i() public pure returns (uint) { return 4; } }"}};
+	ReadCallback::Callback readFile = [&](string const& _path) {
+		if (files.count(_path))
+			return ReadCallback::Result{true, files.at(_path)};
+		return ReadCallback::Result{false, "Not found."};
+	};
+	auto compileFull = [&](StringMap const& _sources) {
+		CompilerStack fullCompilerStack(readFile);
+		fullCompilerStack.setSources(_sources);
+		configure(fullCompilerStack);
+		BOOST_REQUIRE(fullCompilerStack.compile());
+		return formatErrors(fullCompilerStack) + ASTJsonConverter(false, fullCompilerStack.sourceIndices()).toCompactJson(fullCompilerStack.ast("B"));
+	};
+
+	StringMap updatedSources = sources;
+	updatedSources["B"] = "import \"A\"; import \"D\"; contract B is A, D { function g() public pure returns (uint) { return f() + i(); } }";
+	CompilerStack compilerStack(readFile);
+	compilerStack.setSources(updatedSources);
+	configure(compilerStack);
+	BOOST_REQUIRE(compilerStack.compile());
+	SourceUnit const* astD = &compilerStack.ast("D");
+
+	// "D" is read again, but kept since it did not change.
+	updatedSources["A"] = "contract A { function f() public pure returns (uint) { return 2; } }";
+	BOOST_REQUIRE(compilerStack.updateSources({{"A", updatedSources["A"]}}));
+	BOOST_CHECK(&compilerStack.ast("D") == astD);
+	BOOST_REQUIRE(compilerStack.compile());
+	string result = formatErrors(compilerStack) + ASTJsonConverter(false, compilerStack.sourceIndices()).toCompactJson(compilerStack.ast("B"));
+	BOOST_CHECK_EQUAL(result, compileFull(updatedSources));
+
+	// A changed file is read again together with the sources importing it.
+	files["D"] = "contract D { function i() public pure returns (uint) { uint w; return 5; } }";
+	updatedSources["C"] = "contract C { function h() public { uint x; uint v; } }";
+	BOOST_REQUIRE(compilerStack.updateSources({{"C", updatedSources["C"]}}));
+	BOOST_CHECK(compilerStack.sourceNames() == vector<string>({"A", "B", "C", "D", "E"}));
+	BOOST_REQUIRE(compilerStack.compile());
+	result = formatErrors(compilerStack) + ASTJsonConverter(false, compilerStack.sourceIndices()).toCompactJson(compilerStack.ast("B"));
+	BOOST_CHECK_EQUAL(result, compileFull(updatedSources));
+
+	// A file that is not imported anymore is dropped.
+	updatedSources["B"] = sources.at("B");
+	BOOST_REQUIRE(compilerStack.updateSources({{"B", updatedSources["B"]}}));
+	BOOST_CHECK(compilerStack.sourceNames() == vector<string>({"A", "B", "C", "E"}));
+	checkSameAsFullCompilation(compilerStack, updatedSources);
+}
+
+BOOST_AUTO_TEST_CASE(recovers_from_errors)
+{
+	CompilerStack compilerStack;
+	compilerStack.setSources(sources);
+	configure(compilerStack);
+	BOOST_REQUIRE(compilerStack.compile());
+
+	StringMap updatedSources = sources;
+	updatedSources["A"] = "contract A { function f() public pure returns (uint) { return x; } }";
+	BOOST_REQUIRE(compilerStack.updateSources({{"A", updatedSources["A"]}}));
+	BOOST_CHECK(!compilerStack.analyze());
+	BOOST_CHECK(!Error::containsOnlyWarnings(compilerStack.errors()));
+
+	updatedSources["A"] = "contract A { function f() public pure returns (uint) { return 3 }";
+	BOOST_CHECK(!compilerStack.updateSources({{"A", updatedSources["A"]}}));
+
+	updatedSources["A"] = "contract A { function f() public pure returns (uint) { return 3; } }";
+	BOOST_REQUIRE(compilerStack.updateSources({{"A", updatedSources["A"]}}));
+	checkSameAsFullCompilation(compilerStack, updatedSources);
+}
+
+BOOST_AUTO_TEST_CASE(new_sources)
+{
+	CompilerStack compilerStack;
+	compilerStack.setSources(sources);
+	configure(compilerStack);
+	BOOST_REQUIRE(compilerStack.compile());
+
+	StringMap updatedSources = sources;
+	updatedSources["B"] = "import \"A\"; import \"D\"; contract B is A, D { function g() public pure returns (uint) { return f() + i(); } }";
+	updatedSources["D"] = "contract D { function i() public pure returns (uint) { return 4; } }";
+	BOOST_REQUIRE(compilerStack.updateSources({{"B", updatedSources["B"]}, {"D", updatedSources["D"]}}));
+	checkSameAsFullCompilation(compilerStack, updatedSources);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+} // end namespaces
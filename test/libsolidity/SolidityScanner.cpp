@@ -648,6 +648,27 @@ BOOST_AUTO_TEST_CASE(irregular_line_breaks_in_strings)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(long_comments_and_strings)
+{
+	// Longer than the blocks used for bulk scanning, with special characters at all offsets.
+	for (size_t offset = 0; offset < 40; offset++)
+	{
+		string text(offset, 'x');
+		Scanner scanner(CharStream(
+			"/* " + text + "* */ // " + text + "\xC2\xA0\n"
+			"/// " + text + "\xC2\xA0\n"
+			"/** " + text + "*\n * " + text + "*/"
+			"\"" + text + "\\n" + text + "'\xC2\xA0\" 'a",
+			""
+		));
+		BOOST_CHECK_EQUAL(scanner.currentToken(), Token::StringLiteral);
+		BOOST_CHECK_EQUAL(scanner.currentCommentLiteral(), text + "*\n" + text);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), text + "\n" + text + "'\xC2\xA0");
+		BOOST_CHECK_EQUAL(scanner.next(), Token::Illegal);
+		BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -21,6 +21,7 @@
  */
 
 #include <libsolidity/ast/Types.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/AST.h>
 #include <libdevcore/Keccak256.h>
 #include <boost/test/unit_test.hpp>
@@ -78,6 +79,29 @@ BOOST_AUTO_TEST_CASE(ufixed_types)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(shared_elementary_types)
+{
+	TypePointer uint8;
+	{
+		TypeProvider provider;
+		TypeProvider::Scope scope(provider);
+		BOOST_CHECK(Type::fromElementaryTypeName("uint") == Type::fromElementaryTypeName("uint256"));
+		BOOST_CHECK(Type::fromElementaryTypeName("byte") == Type::fromElementaryTypeName("bytes1"));
+		BOOST_CHECK(Type::fromElementaryTypeName("bool") == TypeProvider::boolean());
+		BOOST_CHECK(Type::fromElementaryTypeName("address payable") == TypeProvider::payableAddress());
+		BOOST_CHECK(TypeProvider::integer(8, IntegerType::Modifier::Signed) != TypeProvider::integer(8));
+		uint8 = TypeProvider::integer(8);
+
+		TypeProvider otherProvider;
+		TypeProvider::Scope otherScope(otherProvider);
+		BOOST_CHECK(uint8 != TypeProvider::integer(8));
+		BOOST_CHECK(*uint8 == *TypeProvider::integer(8));
+	}
+	// Without an active provider, every request gets a new instance.
+	BOOST_CHECK(TypeProvider::integer(8) != TypeProvider::integer(8));
+	BOOST_CHECK(*uint8 == *TypeProvider::integer(8));
+}
+
 BOOST_AUTO_TEST_CASE(storage_layout_simple)
 {
 	MemberList members(MemberList::MemberMap({
@@ -22,9 +22,14 @@
 #include <string>
 #include <boost/test/unit_test.hpp>
 #include <libsolidity/interface/StandardCompiler.h>
+#include <libyul/optimiser/Suite.h>
 #include <libdevcore/JSON.h>
 #include <test/Metadata.h>
 
+#include <boost/filesystem.hpp>
+
+#include <sstream>
+
 using namespace std;
 using namespace dev::eth;
 
@@ -83,15 +88,51 @@ Json::Value getContractResult(Json::Value const& _compilerResult, string const&
 	return _compilerResult["contracts"][_file][_name];
 }
 
-Json::Value compile(string const& _input)
+Json::Value compile(string const& _input, shared_ptr<CompilationCache> _cache = nullptr)
 {
 	StandardCompiler compiler;
+	compiler.setCompilationCache(std::move(_cache));
 	string output = compiler.compile(_input);
 	Json::Value ret;
 	BOOST_REQUIRE(jsonParseStrict(output, ret));
 	return ret;
 }
 
+/// Stream buffer that fails once, when a write would exceed @a _limit bytes.
+class FailingStreamBuffer: public streambuf
+{
+public:
+	explicit FailingStreamBuffer(size_t _limit): m_limit(_limit) {}
+
+	string const& str() const { return m_data; }
+
+protected:
+	streamsize xsputn(char const* _data, streamsize _size) override
+	{
+		if (!m_failed && m_data.size() + size_t(_size) > m_limit)
+		{
+			m_failed = true;
+			throw runtime_error("Write failed.");
+		}
+		m_data.append(_data, size_t(_size));
+		return _size;
+	}
+
+	int_type overflow(int_type _char) override
+	{
+		if (traits_type::eq_int_type(_char, traits_type::eof()))
+			return traits_type::not_eof(_char);
+		char character = traits_type::to_char_type(_char);
+		xsputn(&character, 1);
+		return _char;
+	}
+
+private:
+	size_t m_limit;
+	string m_data;
+	bool m_failed = false;
+};
+
 } // end anonymous namespace
 
 BOOST_AUTO_TEST_SUITE(StandardCompiler)
@@ -1025,6 +1066,90 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_steps)
+{
+	auto inputForSteps = [](string const& _steps)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"settings": {
+					"optimizer": { "details": { "yul": true, "yulDetails": { "optimizerSteps": )" + _steps + R"( } } },
+					"outputSelection": { "fileA": { "A": [ "evm.bytecode.object", "metadata" ] } }
+				},
+				"sources": {
+					"fileA": { "content": "pragma experimental ABIEncoderV2; contract A { function f(uint[] memory a) public returns (uint[] memory) { return a; } }" }
+				}
+			}
+		)";
+	};
+
+	Json::Value result = compile(inputForSteps("\"dhf[xarrsc]jmu\""));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_REQUIRE(contract.isObject());
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].asString().length() > 20);
+	Json::Value metadata;
+	BOOST_REQUIRE(jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK_EQUAL(
+		metadata["settings"]["optimizer"]["details"]["yulDetails"]["optimizerSteps"].asString(),
+		"dhf[xarrsc]jmu"
+	);
+
+	result = compile(inputForSteps("\"" + string(yul::OptimiserSuite::DefaultSteps) + "\""));
+	contract = getContractResult(result, "fileA", "A");
+	BOOST_REQUIRE(jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK(!metadata["settings"]["optimizer"]["details"]["yulDetails"].isMember("optimizerSteps"));
+
+	result = compile(inputForSteps("\"dhf[x[a]]\""));
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"Invalid optimizer step sequence in \"settings.optimizer.details.yulDetails.optimizerSteps\": "
+		"Nested brackets are not supported in optimizer step sequences."
+	));
+	result = compile(inputForSteps("1"));
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"\"settings.optimizer.details.yulDetails.optimizerSteps\" must be a string."
+	));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_separate_functions)
+{
+	auto inputForParallelism = [](string const& _parallelism)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"settings": {
+					"parallelism": )" + _parallelism + R"(,
+					"optimizer": { "details": { "yul": true, "yulDetails": { "separateFunctions": true } } },
+					"outputSelection": { "fileA": { "A": [ "evm.bytecode.object", "metadata" ] } }
+				},
+				"sources": {
+					"fileA": { "content": "pragma experimental ABIEncoderV2; contract A { function f(uint[][] memory a, bytes memory b) public returns (uint[][] memory, bytes memory) { return (a, b); } }" }
+				}
+			}
+		)";
+	};
+
+	Json::Value result = compile(inputForParallelism("1"));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_REQUIRE(contract.isObject());
+	Json::Value metadata;
+	BOOST_REQUIRE(jsonParseStrict(contract["metadata"].asString(), metadata));
+	BOOST_CHECK(metadata["settings"]["optimizer"]["details"]["yulDetails"]["separateFunctions"].asBool());
+
+	Json::Value parallelResult = compile(inputForParallelism("4"));
+	BOOST_CHECK_EQUAL(
+		getContractResult(parallelResult, "fileA", "A")["evm"]["bytecode"]["object"].asString(),
+		contract["evm"]["bytecode"]["object"].asString()
+	);
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -1156,6 +1281,336 @@ BOOST_AUTO_TEST_CASE(use_stack_optimization)
 	BOOST_CHECK(result["errors"][0]["type"] == "InternalCompilerError");
 }
 
+BOOST_AUTO_TEST_CASE(parallelism_invalid)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"parallelism": -1
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be an unsigned number."));
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_same_output)
+{
+	auto inputForParallelism = [](string const& _parallelism)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": {
+					"fileA": { "content": "contract A { function f() public returns (uint) { return 1; } }" },
+					"fileB": { "content": "import \"fileA\"; contract B { A a = new A(); }" },
+					"fileC": { "content": "import \"fileA\"; contract C { function g() public { new A(); } }" },
+					"fileD": { "content": "import \"fileB\"; import \"fileC\"; contract D { B b = new B(); C c = new C(); }" }
+				},
+				"settings": {
+					"parallelism": )" + _parallelism + R"(,
+					"optimizer": { "enabled": true },
+					"outputSelection": { "*": { "*": [ "evm.bytecode", "evm.deployedBytecode", "metadata" ] } }
+				}
+			}
+		)";
+	};
+	Json::Value sequential = compile(inputForParallelism("1"));
+	BOOST_CHECK(containsAtMostWarnings(sequential));
+	for (string const& parallelism: {"0", "2", "4"})
+	{
+		Json::Value parallel = compile(inputForParallelism(parallelism));
+		BOOST_CHECK(containsAtMostWarnings(parallel));
+		BOOST_CHECK(parallel["contracts"] == sequential["contracts"]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_same_error)
+{
+	// Every contract fails with "stack too deep", the error of the first one has to be reported.
+	string const deepFunction =
+		"function f(uint a, uint b, uint c, uint d, uint e, uint f, uint g, uint h, uint i, uint j, "
+		"uint k, uint l, uint m, uint n, uint o, uint p, uint q, uint r) public pure returns (uint) { return a; }";
+	auto inputForParallelism = [&](string const& _parallelism)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": {
+					"fileA": { "content": "contract A { )" + deepFunction + R"( }" },
+					"fileB": { "content": "contract B { )" + deepFunction + R"( }" },
+					"fileC": { "content": "contract C { )" + deepFunction + R"( }" },
+					"fileD": { "content": "contract D { )" + deepFunction + R"( }" }
+				},
+				"settings": {
+					"parallelism": )" + _parallelism + R"(,
+					"outputSelection": { "*": { "*": [ "evm.bytecode" ] } }
+				}
+			}
+		)";
+	};
+	Json::Value sequential = compile(inputForParallelism("1"));
+	// The message contains the place in the code of the compiler that reported the error.
+	BOOST_REQUIRE(sequential["errors"].size() == 1);
+	Json::Value const& error = sequential["errors"][0];
+	BOOST_CHECK_EQUAL(error["type"].asString(), "CompilerError");
+	BOOST_CHECK(error["message"].asString().find("Stack too deep, try removing local variables.") != string::npos);
+	BOOST_CHECK_EQUAL(error["sourceLocation"]["file"].asString(), "fileA");
+	for (string const& parallelism: {"0", "2", "4"})
+		for (size_t i = 0; i < 5; ++i)
+			BOOST_CHECK(compile(inputForParallelism(parallelism))["errors"] == sequential["errors"]);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_same_output)
+{
+	char const* input = R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"fileA": { "content": "contract A { function f() public returns (uint) { return 1; } }" },
+				"fileB": { "content": "import \"fileA\"; contract B { A a = new A(); }" }
+			},
+			"settings": {
+				"outputSelection": { "*": { "*": [ "evm.bytecode", "evm.deployedBytecode", "evm.assembly", "evm.legacyAssembly" ] } }
+			}
+		}
+	)";
+	Json::Value uncached = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(uncached));
+
+	boost::filesystem::path directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+	auto cache = make_shared<CompilationCache>(directory.string());
+	for (size_t i = 0; i < 2; ++i)
+	{
+		Json::Value cached = compile(input, cache);
+		BOOST_CHECK(containsAtMostWarnings(cached));
+		BOOST_CHECK(cached["contracts"] == uncached["contracts"]);
+		BOOST_CHECK(!boost::filesystem::is_empty(directory));
+	}
+	boost::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_eviction)
+{
+	auto inputForContract = [](string const& _name)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": {
+					"fileA": { "content": "contract )" + _name + R"( { function f() public returns (uint) { return 1; } } contract Other {}" }
+				},
+				"settings": {
+					"outputSelection": { "*": { "*": [ "evm.bytecode" ] } }
+				}
+			}
+		)";
+	};
+	auto entryCount = [](boost::filesystem::path const& _directory)
+	{
+		return distance(boost::filesystem::directory_iterator(_directory), boost::filesystem::directory_iterator());
+	};
+
+	boost::filesystem::path directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+	// Too small for any entry: only the entries of the last compilation are kept.
+	auto cache = make_shared<CompilationCache>(directory.string(), 1);
+	BOOST_CHECK(containsAtMostWarnings(compile(inputForContract("A"), cache)));
+	BOOST_CHECK_EQUAL(entryCount(directory), 2);
+	BOOST_CHECK(containsAtMostWarnings(compile(inputForContract("B"), cache)));
+	BOOST_CHECK_EQUAL(entryCount(directory), 2);
+	boost::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_CASE(retained_compiler_stack)
+{
+	auto input = [](string const& _source, string const& _outputs)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": { "fileA": { "content": ")" + _source + R"(" } },
+				"settings": { "outputSelection": { "fileA": { "A": [ )" + _outputs + R"( ] } } }
+			}
+		)";
+	};
+	string const sourceA = "contract A { function f() public returns (uint) { return 1; } }";
+	string const sourceB = "contract A { function f() public returns (uint) { return 2; } }";
+
+	dev::solidity::StandardCompiler compiler;
+	compiler.setRetainCompilerStack(true);
+	for (auto const& request: vector<pair<string, string>>{
+		{sourceA, "\"evm.bytecode\", \"abi\""},
+		{sourceA, "\"evm.bytecode\", \"metadata\""},
+		{sourceB, "\"evm.bytecode\", \"metadata\""},
+		{sourceB, "\"abi\""}
+	})
+	{
+		Json::Value retained;
+		BOOST_REQUIRE(jsonParseStrict(compiler.compile(input(request.first, request.second)), retained));
+		BOOST_CHECK(containsAtMostWarnings(retained));
+		BOOST_CHECK(retained == compile(input(request.first, request.second)));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(retained_compiler_stack_updated_sources)
+{
+	auto input = [](map<string, string> const& _sources)
+	{
+		string sources;
+		for (auto const& source: _sources)
+			sources += (sources.empty() ? "" : ",") + ("\"" + source.first + "\": { \"content\": \"" + source.second + "\" }");
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": { )" + sources + R"( },
+				"settings": { "outputSelection": { "*": { "*": [ "evm.bytecode", "metadata" ], "": [ "ast" ] } } }
+			}
+		)";
+	};
+	map<string, string> sources{
+		{"fileA", "contract A { function f() public returns (uint) { return 1; } }"},
+		{"fileB", "import \\\"fileA\\\"; contract B is A { function g() public returns (uint) { return f(); } }"},
+		{"fileC", "contract C { function h() public returns (uint) { return 3; } }"}
+	};
+
+	dev::solidity::StandardCompiler compiler;
+	compiler.setRetainCompilerStack(true);
+	for (auto const& update: vector<pair<string, string>>{
+		{"fileC", "contract C { function h() public returns (uint) { return 3; } }"},
+		{"fileA", "contract A { function f() public returns (uint) { uint x = 2; return x; } }"},
+		{"fileC", "contract C { function h() public returns (uint) { return 4; } }"},
+		{"fileA", "contract A { function f() public returns (uint) { return 1 }"},
+		{"fileA", "contract A { function f() public returns (uint) { return 5; } }"}
+	})
+	{
+		sources[update.first] = update.second;
+		Json::Value retained;
+		BOOST_REQUIRE(jsonParseStrict(compiler.compile(input(sources)), retained));
+		BOOST_CHECK(retained == compile(input(sources)));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(profiling)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"profiling": true,
+			"outputSelection": { "fileA": { "A": [ "evm.bytecode" ] } }
+		},
+		"sources": {
+			"fileA": { "content": "contract A { }" }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_REQUIRE(result["profiling"].isArray());
+	set<string> phases;
+	for (Json::Value const& entry: result["profiling"])
+	{
+		BOOST_CHECK(entry["calls"].asUInt() > 0);
+		phases.insert(entry["phase"].asString());
+	}
+	BOOST_CHECK(phases.count("parsing"));
+	BOOST_CHECK(phases.count("analysis/TypeChecker"));
+	BOOST_CHECK(phases.count("codegen/ContractCompiler"));
+
+	BOOST_CHECK(!compile(R"({
+		"language": "Solidity",
+		"sources": { "fileA": { "content": "contract A { }" } }
+	})").isMember("profiling"));
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output)
+{
+	// Source names whose order differs from the order of the contract names "a.b:A", "a:B", ...
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a": { "content": "contract B { function f() public {} } contract A is B { }" },
+			"a.b": { "content": "pragma solidity >=0.0; contract A { uint x; }" },
+			"c\"\\": { "content": "contract C { function g() public { uint unused; } }" }
+		},
+		"settings": {
+			"outputSelection": { "*": { "*": [ "abi", "evm.bytecode", "evm.assembly" ], "": [ "ast" ] } }
+		}
+	}
+	)";
+	dev::solidity::StandardCompiler compiler;
+	Json::Value parsedInput;
+	BOOST_REQUIRE(jsonParseStrict(input, parsedInput));
+	string const expectation = jsonCompactPrint(compiler.compile(parsedInput));
+	BOOST_CHECK_EQUAL(compiler.compile(string(input)), expectation);
+	ostringstream stream;
+	compiler.compile(input, stream);
+	BOOST_CHECK_EQUAL(stream.str(), expectation);
+
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["contracts"]["a"].isMember("B"));
+	BOOST_CHECK(result["contracts"]["a.b"].isMember("A"));
+	BOOST_CHECK(result["sources"]["c\"\\"].isMember("ast"));
+
+	for (string const& invalid: {"{", "{\"language\": \"Solidity\"}", "{\"language\": \"Solidity\", \"sources\": {\"a\": {\"content\": \"contract\"}}}"})
+	{
+		Json::Value parsedInvalid;
+		jsonParse(invalid, parsedInvalid);
+		ostringstream invalidStream;
+		compiler.compile(invalid, invalidStream);
+		BOOST_CHECK_EQUAL(invalidStream.str(), compiler.compile(invalid));
+		if (invalid != "{")
+			BOOST_CHECK_EQUAL(invalidStream.str(), jsonCompactPrint(compiler.compile(parsedInvalid)));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output_write_error)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"fileA": { "content": "contract A { function f() public {} }" },
+			"fileB": { "content": "contract B { function g() public {} }" }
+		},
+		"settings": {
+			"outputSelection": { "*": { "*": [ "evm.bytecode" ] } }
+		}
+	}
+	)";
+	dev::solidity::StandardCompiler compiler;
+	string const expectation = compiler.compile(string(input));
+	BOOST_REQUIRE(expectation.find("},\"fileB\"") != string::npos);
+	BOOST_REQUIRE(expectation.find(",\"errors\"") != string::npos);
+
+	// Fail before anything is written, after the first contract is written and
+	// while the remaining members are written at the end.
+	for (size_t limit: {size_t(0), expectation.find("},\"fileB\""), expectation.find(",\"errors\"")})
+	{
+		FailingStreamBuffer buffer(limit);
+		ostream stream(&buffer);
+		stream.exceptions(ios::badbit);
+		compiler.compile(input, stream);
+
+		// The error is part of the same document.
+		Json::Value result;
+		BOOST_REQUIRE(jsonParseStrict(buffer.str(), result));
+		BOOST_REQUIRE(result["errors"].size() == 1);
+		BOOST_CHECK_EQUAL(result["errors"][0]["severity"].asString(), "error");
+		BOOST_CHECK_EQUAL(result.isMember("contracts"), limit > 0);
+		BOOST_CHECK_EQUAL(result["contracts"].isMember("fileB"), limit > expectation.find("},\"fileB\""));
+		BOOST_CHECK(!result.isMember("sources"));
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,120 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the hashes of code used to detect changes.
+ */
+
+#include <test/Options.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/AsmData.h>
+
+using namespace std;
+
+namespace yul
+{
+namespace test
+{
+
+namespace
+{
+
+uint64_t hash(string const& _source)
+{
+	return BlockHasher::run(disambiguate(_source, false));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulBlockHasher)
+
+BOOST_AUTO_TEST_CASE(variable_names_are_ignored)
+{
+	BOOST_CHECK_EQUAL(
+		hash("{ let a := mload(0) let b := add(a, 1) sstore(b, a) }"),
+		hash("{ let x := mload(0) let y := add(x, 1) sstore(y, x) }")
+	);
+	BOOST_CHECK_EQUAL(
+		hash("{ function f(a) -> r { r := a } }"),
+		hash("{ function f(b) -> s { s := b } }")
+	);
+	// The order of the declarations matters.
+	BOOST_CHECK(
+		hash("{ let a := mload(0) let b := mload(1) sstore(b, a) }") !=
+		hash("{ let a := mload(0) let b := mload(1) sstore(a, b) }")
+	);
+}
+
+BOOST_AUTO_TEST_CASE(code_differences)
+{
+	uint64_t base = hash("{ let a := mload(0) sstore(a, 1) }");
+	BOOST_CHECK_EQUAL(hash("{ let a := mload(0) sstore(a, 1) }"), base);
+	BOOST_CHECK(hash("{ let a := mload(0) sstore(a, 2) }") != base);
+	BOOST_CHECK(hash("{ let a := mload(0) mstore(a, 1) }") != base);
+	BOOST_CHECK(hash("{ let a := mload(0) sstore(1, a) }") != base);
+	BOOST_CHECK(hash("{ let a := mload(0) { sstore(a, 1) } }") != base);
+	BOOST_CHECK(hash("{ let a := mload(0) if a { sstore(a, 1) } }") != base);
+	BOOST_CHECK(hash("{ let a := \"abc\" sstore(a, 1) }") != hash("{ let a := \"abd\" sstore(a, 1) }"));
+	BOOST_CHECK(hash("{ function f() {} f() }") != hash("{ function g() {} g() }"));
+	BOOST_CHECK(
+		hash("{ switch mload(0) case 0 { } default { sstore(0, 1) } }") !=
+		hash("{ switch mload(0) case 0 { sstore(0, 1) } default { } }")
+	);
+}
+
+BOOST_AUTO_TEST_CASE(number_literals)
+{
+	BOOST_CHECK_EQUAL(hash("{ sstore(0x10, 0) }"), hash("{ sstore(16, 0) }"));
+	BOOST_CHECK_EQUAL(hash("{ sstore(0, 0) }"), hash("{ sstore(0x0, 0) }"));
+	BOOST_CHECK(hash("{ sstore(0x10, 0) }") != hash("{ sstore(10, 0) }"));
+}
+
+BOOST_AUTO_TEST_CASE(function_names_are_ignored)
+{
+	Block block = disambiguate(
+		"{ function f(a) -> r { r := add(a, 1) } function g(b) -> s { s := add(b, 1) }"
+		"  function h(c) -> t { t := add(c, 2) } }",
+		false
+	);
+	BOOST_REQUIRE_EQUAL(block.statements.size(), 3);
+	uint64_t f = BlockHasher::run(boost::get<FunctionDefinition>(block.statements[0]));
+	uint64_t g = BlockHasher::run(boost::get<FunctionDefinition>(block.statements[1]));
+	uint64_t h = BlockHasher::run(boost::get<FunctionDefinition>(block.statements[2]));
+	BOOST_CHECK_EQUAL(f, g);
+	BOOST_CHECK(f != h);
+}
+
+BOOST_AUTO_TEST_CASE(expressions)
+{
+	Block block = disambiguate(
+		"{ let a := 1 let b := 2 let x := add(a, 0x10) let y := add(a, 16) let z := add(b, 16) }",
+		false
+	);
+	BOOST_REQUIRE_EQUAL(block.statements.size(), 5);
+	auto valueHash = [&](size_t _index) {
+		return BlockHasher::run(*boost::get<VariableDeclaration>(block.statements[_index]).value);
+	};
+	BOOST_CHECK_EQUAL(valueHash(2), valueHash(3));
+	BOOST_CHECK(valueHash(2) != valueHash(4));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
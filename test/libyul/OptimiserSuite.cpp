@@ -0,0 +1,171 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the step sequences of the optimiser suite.
+ */
+
+#include <test/Options.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/Suite.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/Exceptions.h>
+
+#include <libdevcore/Profiler.h>
+
+using namespace std;
+
+namespace yul
+{
+namespace test
+{
+
+namespace
+{
+
+string optimise(string const& _source, string const& _steps, bool _separateFunctions = false, unsigned _jobs = 1)
+{
+	auto parsed = parse(_source, false);
+	BOOST_REQUIRE(parsed.first);
+	OptimiserSuite::run(
+		EVMDialect::strictAssemblyForEVM(dev::test::Options::get().evmVersion()),
+		*parsed.first,
+		*parsed.second,
+		true,
+		{},
+		_steps,
+		_separateFunctions,
+		_jobs
+	);
+	return AsmPrinter{}(*parsed.first);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulOptimiserSuite)
+
+BOOST_AUTO_TEST_CASE(valid_sequences)
+{
+	BOOST_CHECK_NO_THROW(OptimiserSuite::validateSteps(OptimiserSuite::DefaultSteps));
+	BOOST_CHECK_NO_THROW(OptimiserSuite::validateSteps(""));
+	BOOST_CHECK_NO_THROW(OptimiserSuite::validateSteps("dhf[xarrsc]jmu"));
+	BOOST_CHECK_NO_THROW(OptimiserSuite::validateSteps(" x a\n[ r ]\t[]"));
+	for (auto const& step: OptimiserSuite::stepAbbreviations())
+		BOOST_CHECK_NO_THROW(OptimiserSuite::validateSteps(string(1, step.first)));
+}
+
+BOOST_AUTO_TEST_CASE(invalid_sequences)
+{
+	BOOST_CHECK_THROW(OptimiserSuite::validateSteps("z"), OptimizerException);
+	BOOST_CHECK_THROW(OptimiserSuite::validateSteps("xa,r"), OptimizerException);
+	BOOST_CHECK_THROW(OptimiserSuite::validateSteps("[x[a]]"), OptimizerException);
+	BOOST_CHECK_THROW(OptimiserSuite::validateSteps("[xa"), OptimizerException);
+	BOOST_CHECK_THROW(OptimiserSuite::validateSteps("xa]"), OptimizerException);
+	BOOST_CHECK_THROW(optimise("{ }", "q"), OptimizerException);
+}
+
+BOOST_AUTO_TEST_CASE(abbreviations)
+{
+	map<char, string> const& steps = OptimiserSuite::stepAbbreviations();
+	BOOST_CHECK_EQUAL(steps.size(), 19);
+	BOOST_CHECK_EQUAL(steps.at('x'), "ExpressionSplitter");
+	BOOST_CHECK_EQUAL(steps.at('u'), "UnusedPruner");
+	BOOST_CHECK_EQUAL(steps.at('V'), "SSAReverser");
+}
+
+BOOST_AUTO_TEST_CASE(custom_sequences)
+{
+	string source = "{ let a := add(1, 2) let b := mload(0) sstore(a, b) }";
+	// Without steps, only the code generation preparation is done, which includes the
+	// FunctionGrouper.
+	BOOST_CHECK_EQUAL(
+		optimise(source, ""),
+		format("{ { let a := add(1, 2) let b := mload(0) sstore(a, b) } }", false)
+	);
+	BOOST_CHECK_EQUAL(
+		optimise(source, "s"),
+		format("{ { let a := 3 let b := mload(0) sstore(a, b) } }", false)
+	);
+	BOOST_CHECK_EQUAL(optimise(source, "sjmu"), format("{ { sstore(3, mload(0)) } }", false));
+	BOOST_CHECK_EQUAL(optimise(source, OptimiserSuite::DefaultSteps), optimise(source, "[sjmu]"));
+}
+
+BOOST_AUTO_TEST_CASE(steps_without_prerequisites)
+{
+	// The FullInliner and the EquivalentFunctionCombiner require hoisted functions, which is
+	// ensured by the suite itself.
+	string source =
+		"{ sstore(0, f(1)) "
+		"function f(a) -> r { function g(b) -> s { s := add(b, 1) } r := g(a) } "
+		"function h(a) -> r { r := add(a, 1) } }";
+	BOOST_CHECK_NO_THROW(optimise(source, "gi"));
+	BOOST_CHECK_NO_THROW(optimise(source, "v"));
+	BOOST_CHECK_NO_THROW(optimise(source, "xi[xarrsc]"));
+	BOOST_CHECK_EQUAL(optimise(source, "gi"), optimise(source, "hgi"));
+}
+
+BOOST_AUTO_TEST_CASE(separate_functions)
+{
+	string source;
+	for (size_t i = 0; i < 20; ++i)
+	{
+		string const index = to_string(i);
+		source +=
+			"function f" + index + "(a, b) -> r {\n"
+			"  let x := add(mul(a, " + index + "), calldataload(b))\n"
+			"  for { let i := 0 } lt(i, a) { i := add(i, 1) } { x := xor(x, sload(add(i, b))) }\n"
+			"  r := add(x, f" + to_string(i == 0 ? 0 : i - 1) + "(b, x))\n"
+			"}\n";
+	}
+	source = "{\n" + source + "sstore(0, f19(calldataload(0), calldataload(32)))\n}";
+
+	string result = optimise(source, OptimiserSuite::DefaultSteps, true, 1);
+	BOOST_CHECK_EQUAL(optimise(source, OptimiserSuite::DefaultSteps, true, 4), result);
+	BOOST_CHECK_EQUAL(optimise(source, OptimiserSuite::DefaultSteps, true, 4), result);
+	// Steps that cannot be applied to each function are run on all of the code.
+	BOOST_CHECK_EQUAL(optimise(source, "u", true, 4), optimise(source, "u"));
+}
+
+BOOST_AUTO_TEST_CASE(unchanged_code_is_skipped)
+{
+	string source =
+		"{ sstore(add(1, 2), f(0)) sstore(g(0), 0) "
+		"function f(a) -> r { r := calldataload(a) } "
+		"function g(a) -> r { r := sload(a) } }";
+
+	dev::Profiler profiler;
+	BOOST_REQUIRE(profiler.activate());
+	string result = optimise(source, "gsss");
+	profiler.deactivate();
+	BOOST_CHECK_EQUAL(result, optimise(source, "gs"));
+
+	// The first run of the simplifier only changes the main block, the second run
+	// does not change anything and the third one is skipped entirely.
+	size_t simplifierRuns = 0;
+	for (auto const& event: profiler.events())
+		if (event.phase == "yul/ExpressionSimplifier")
+			++simplifierRuns;
+	BOOST_CHECK_EQUAL(simplifierRuns, 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -0,0 +1,137 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the Yul string repository and maps keyed by Yul strings.
+ */
+
+#include <libyul/YulString.h>
+#include <libyul/YulStringMap.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace yul
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest)
+
+BOOST_AUTO_TEST_CASE(identity)
+{
+	YulString a("abc");
+	BOOST_CHECK(a == YulString("abc"));
+	BOOST_CHECK(a != YulString("abd"));
+	BOOST_CHECK_EQUAL(a.str(), "abc");
+	BOOST_CHECK(YulString("").empty());
+	BOOST_CHECK(YulString() == YulString(""));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_lookups)
+{
+	vector<vector<YulString>> results(4);
+	vector<thread> threads;
+	for (size_t t = 0; t < results.size(); ++t)
+		threads.emplace_back([&, t]() {
+			for (size_t i = 0; i < 10000; ++i)
+				results[t].emplace_back("name_" + to_string(i));
+		});
+	for (auto& thread: threads)
+		thread.join();
+	for (size_t i = 0; i < 10000; ++i)
+	{
+		for (size_t t = 1; t < results.size(); ++t)
+			BOOST_CHECK(results[t][i] == results[0][i]);
+		BOOST_CHECK_EQUAL(results[0][i].str(), "name_" + to_string(i));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(reset)
+{
+	YulStringRepository& repository = YulStringRepository::instance();
+	{
+		YulStringRepository::Lease lease;
+		YulString("only_used_here");
+		size_t size = repository.size();
+		BOOST_CHECK(!repository.reset());
+		BOOST_CHECK_EQUAL(repository.size(), size);
+	}
+	YulString zero("0");
+	YulString trueString("true");
+	BOOST_CHECK(repository.reset());
+	BOOST_CHECK_EQUAL(repository.size(), 4);
+	// Predefined strings are kept.
+	BOOST_CHECK(zero == YulString("0"));
+	BOOST_CHECK(trueString == YulString("true"));
+	BOOST_CHECK_EQUAL(zero.str(), "0");
+	BOOST_CHECK_EQUAL(YulString("only_used_here").str(), "only_used_here");
+}
+
+BOOST_AUTO_TEST_CASE(map_insert_and_erase)
+{
+	YulStringMap<size_t> map;
+	BOOST_CHECK(map.empty());
+	BOOST_CHECK(!map.find(YulString("x")));
+	map[YulString("x")] = 1;
+	map[YulString("y")] += 2;
+	BOOST_CHECK_EQUAL(map.size(), 2);
+	BOOST_CHECK_EQUAL(map.at(YulString("x")), 1);
+	BOOST_CHECK_EQUAL(map.at(YulString("y")), 2);
+	BOOST_CHECK_EQUAL(map.count(YulString("z")), 0);
+	BOOST_CHECK_THROW(map.at(YulString("z")), std::out_of_range);
+	BOOST_CHECK_EQUAL(map.erase(YulString("x")), 1);
+	BOOST_CHECK_EQUAL(map.erase(YulString("x")), 0);
+	BOOST_CHECK_EQUAL(map.size(), 1);
+	BOOST_CHECK_EQUAL(map.count(YulString("x")), 0);
+	BOOST_CHECK_EQUAL(map.at(YulString("y")), 2);
+}
+
+BOOST_AUTO_TEST_CASE(map_matches_std_map)
+{
+	mt19937 random(42);
+	vector<YulString> keys;
+	for (size_t i = 0; i < 300; ++i)
+		keys.emplace_back("key_" + to_string(i));
+	YulStringMap<size_t> map;
+	std::map<YulString, size_t> reference;
+	for (size_t i = 0; i < 20000; ++i)
+	{
+		YulString key = keys[random() % keys.size()];
+		if (random() % 3 == 0)
+			BOOST_CHECK_EQUAL(map.erase(key), reference.erase(key));
+		else
+			map[key] = reference[key] = i;
+		BOOST_REQUIRE_EQUAL(map.size(), reference.size());
+	}
+	for (YulString key: keys)
+	{
+		BOOST_REQUIRE_EQUAL(map.count(key), reference.count(key));
+		if (reference.count(key))
+			BOOST_CHECK_EQUAL(map.at(key), reference.at(key));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
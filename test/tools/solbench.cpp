@@ -0,0 +1,497 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmark of the compiler throughput on a corpus of contracts.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolidity/interface/Version.h>
+#include <libsolidity/ast/ASTJsonConverter.h>
+#include <liblangutil/Exceptions.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+#include <libyul/Exceptions.h>
+#include <libyul/optimiser/Suite.h>
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/JSON.h>
+#include <libdevcore/Profiler.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+using namespace langutil;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+struct Corpus
+{
+	string name;
+	StringMap sources;
+};
+
+map<string, OptimiserSettings> const c_settings{
+	{"default", OptimiserSettings::minimal()},
+	{"optimize", OptimiserSettings::standard()},
+	{"optimize-yul", OptimiserSettings::full()}
+};
+
+/// @returns the optimizer settings called @a _name: One of c_settings or "yul:" followed
+/// by a Yul optimizer step sequence, which is used together with the settings of "optimize-yul".
+boost::optional<OptimiserSettings> optimiserSettings(string const& _name)
+{
+	if (c_settings.count(_name))
+		return c_settings.at(_name);
+	if (!boost::starts_with(_name, "yul:"))
+		return boost::none;
+	OptimiserSettings settings = OptimiserSettings::full();
+	settings.yulOptimiserSteps = _name.substr(4);
+	try
+	{
+		yul::OptimiserSuite::validateSteps(settings.yulOptimiserSteps);
+	}
+	catch (yul::OptimizerException const&)
+	{
+		return boost::none;
+	}
+	return settings;
+}
+
+/// Reads all Solidity files below @a _directory. The source names are relative to the parent
+/// of the directory, so that relative imports between the files resolve.
+Corpus loadCorpus(fs::path const& _directory)
+{
+	Corpus corpus;
+	corpus.name = _directory.filename().string();
+	for (fs::recursive_directory_iterator it(_directory), end; it != end; ++it)
+		if (fs::is_regular_file(it->path()) && it->path().extension() == ".sol")
+		{
+			string name = corpus.name + "/" + fs::relative(it->path(), _directory).generic_string();
+			corpus.sources[name] = readFileAsString(it->path().string());
+		}
+	return corpus;
+}
+
+/// @returns a single source of @a _functions functions with loops, arithmetic and storage
+/// accesses, spread over a chain of contracts inheriting from each other.
+Corpus generatedCorpus(unsigned _functions)
+{
+	unsigned const functionsPerContract = 20;
+	string source = "pragma solidity >=0.5.0;\n";
+	for (unsigned i = 0; i < _functions; ++i)
+	{
+		string const index = to_string(i);
+		if (i % functionsPerContract == 0)
+		{
+			string const contract = to_string(i / functionsPerContract);
+			if (i > 0)
+				source += "}\n";
+			source += "contract G" + contract;
+			if (i > 0)
+				source += " is G" + to_string(i / functionsPerContract - 1);
+			source += " {\n\tmapping(uint => uint) data" + contract + ";\n";
+		}
+		source +=
+			"\tfunction f" + index + "(uint a, uint b) public returns (uint c) {\n"
+			"\t\tc = a * " + to_string(i + 3) + " + (b >> " + to_string(i % 256) + ");\n"
+			"\t\tfor (uint j = 0; j < a; j++)\n"
+			"\t\t\tc ^= data" + to_string(i / functionsPerContract) + "[j] + j * " + index + ";\n"
+			"\t\tdata" + to_string(i / functionsPerContract) + "[c] = c;\n"
+			"\t}\n";
+	}
+	if (_functions > 0)
+		source += "}\n";
+
+	Corpus corpus;
+	corpus.name = "generated";
+	corpus.sources["generated.sol"] = move(source);
+	return corpus;
+}
+
+/// Resets the peak resident set size of the process, so that the next benchmark
+/// is not attributed the memory of the earlier ones. Only supported on Linux.
+void resetPeakMemory()
+{
+	ofstream clearRefs("/proc/self/clear_refs");
+	clearRefs << "5";
+}
+
+/// @returns the peak resident set size of the process in bytes.
+uint64_t peakMemory()
+{
+	ifstream status("/proc/self/status");
+	string line;
+	while (getline(status, line))
+		if (boost::starts_with(line, "VmHWM:"))
+			return stoull(line.substr(6)) * 1024;
+	return Profiler::peakMemory();
+}
+
+/// Compiles @a _corpus @a _repetitions times.
+/// @returns the timings or null if the corpus does not compile.
+Json::Value runBenchmark(
+	Corpus const& _corpus,
+	string const& _settingsName,
+	OptimiserSettings const& _settings,
+	unsigned _repetitions,
+	unsigned _jobs
+)
+{
+	resetPeakMemory();
+	Profiler profiler;
+	profiler.activate();
+
+	vector<uint64_t> times;
+	uint64_t bytecodeSize = 0;
+	for (unsigned i = 0; i < _repetitions; ++i)
+	{
+		CompilerStack compilerStack;
+		compilerStack.setSources(_corpus.sources);
+		compilerStack.setOptimiserSettings(_settings);
+		compilerStack.setParallelism(_jobs);
+
+		auto start = chrono::steady_clock::now();
+		bool successful = compilerStack.compile();
+		times.push_back(uint64_t(
+			chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count()
+		));
+
+		if (!successful)
+		{
+			cerr << "Compilation of " << _corpus.name << " failed:" << endl;
+			SourceReferenceFormatter formatter(cerr);
+			for (auto const& error: compilerStack.errors())
+				formatter.printExceptionInformation(
+					*error,
+					(error->type() == Error::Type::Warning) ? "Warning" : "Error"
+				);
+			return Json::nullValue;
+		}
+		bytecodeSize = 0;
+		for (string const& contract: compilerStack.contractNames())
+			bytecodeSize += compilerStack.object(contract).bytecode.size();
+	}
+	profiler.deactivate();
+
+	map<string, uint64_t> phaseTimes;
+	for (Profiler::Event const& event: profiler.events())
+		phaseTimes[event.phase] += event.duration;
+
+	sort(times.begin(), times.end());
+	uint64_t bytes = 0;
+	for (auto const& source: _corpus.sources)
+		bytes += source.second.size();
+
+	Json::Value ret(Json::objectValue);
+	ret["corpus"] = _corpus.name;
+	ret["settings"] = _settingsName;
+	ret["sources"] = unsigned(_corpus.sources.size());
+	ret["bytes"] = Json::UInt64(bytes);
+	ret["time"]["min"] = Json::UInt64(times.front());
+	ret["time"]["median"] = Json::UInt64(times[times.size() / 2]);
+	ret["time"]["max"] = Json::UInt64(times.back());
+	ret["peakMemory"] = Json::UInt64(peakMemory());
+	ret["bytecodeSize"] = Json::UInt64(bytecodeSize);
+	ret["phases"] = Json::objectValue;
+	for (auto const& phase: phaseTimes)
+		ret["phases"][phase.first] = Json::UInt64(phase.second / _repetitions);
+	return ret;
+}
+
+/// Exports the ASTs of @a _corpus in the legacy and the compact format @a _repetitions times,
+/// once via JSON values and once by writing them directly.
+/// @returns the timings of both or null if the corpus does not compile or the outputs differ.
+Json::Value runASTBenchmark(Corpus const& _corpus, unsigned _repetitions)
+{
+	CompilerStack compilerStack;
+	compilerStack.setSources(_corpus.sources);
+	if (!compilerStack.parseAndAnalyze())
+	{
+		cerr << "Analysis of " << _corpus.name << " failed." << endl;
+		return Json::nullValue;
+	}
+
+	auto exportASTs = [&](bool _direct, uint64_t& _bytes) -> uint64_t
+	{
+		auto start = chrono::steady_clock::now();
+		_bytes = 0;
+		for (string const& sourceName: compilerStack.sourceNames())
+			for (bool legacy: {true, false})
+			{
+				ASTJsonConverter converter(legacy, compilerStack.sourceIndices());
+				SourceUnit const& ast = compilerStack.ast(sourceName);
+				string json = _direct ? converter.toCompactJson(ast) : jsonCompactPrint(converter.toJson(ast));
+				_bytes += json.size();
+			}
+		return uint64_t(
+			chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count()
+		);
+	};
+
+	for (string const& sourceName: compilerStack.sourceNames())
+		for (bool legacy: {true, false})
+		{
+			ASTJsonConverter converter(legacy, compilerStack.sourceIndices());
+			SourceUnit const& ast = compilerStack.ast(sourceName);
+			if (converter.toCompactJson(ast) != jsonCompactPrint(converter.toJson(ast)))
+			{
+				cerr << "AST export of " << sourceName << " differs between the two methods." << endl;
+				return Json::nullValue;
+			}
+		}
+
+	vector<uint64_t> times;
+	vector<uint64_t> valueTimes;
+	uint64_t bytes = 0;
+	for (unsigned i = 0; i < _repetitions; ++i)
+	{
+		valueTimes.push_back(exportASTs(false, bytes));
+		times.push_back(exportASTs(true, bytes));
+	}
+
+	sort(times.begin(), times.end());
+	sort(valueTimes.begin(), valueTimes.end());
+
+	Json::Value ret(Json::objectValue);
+	ret["corpus"] = _corpus.name;
+	ret["settings"] = "ast-json";
+	ret["sources"] = unsigned(_corpus.sources.size());
+	ret["bytes"] = Json::UInt64(bytes);
+	ret["time"]["min"] = Json::UInt64(times.front());
+	ret["time"]["median"] = Json::UInt64(times[times.size() / 2]);
+	ret["time"]["max"] = Json::UInt64(times.back());
+	ret["valueTime"]["min"] = Json::UInt64(valueTimes.front());
+	ret["valueTime"]["median"] = Json::UInt64(valueTimes[valueTimes.size() / 2]);
+	ret["valueTime"]["max"] = Json::UInt64(valueTimes.back());
+	return ret;
+}
+
+/// Compares the median time and the peak memory of all benchmarks in @a _results to
+/// the same benchmarks in @a _baseline and prints the ones that got worse.
+/// @returns false if any of them got worse by more than @a _tolerance percent.
+bool checkRegressions(Json::Value const& _results, Json::Value const& _baseline, double _tolerance)
+{
+	map<pair<string, string>, Json::Value> baseline;
+	for (Json::Value const& benchmark: _baseline["benchmarks"])
+		baseline[make_pair(benchmark["corpus"].asString(), benchmark["settings"].asString())] = benchmark;
+
+	bool success = true;
+	auto compare = [&](string const& _name, string const& _metric, uint64_t _before, uint64_t _after)
+	{
+		if (_before == 0 || _after <= _before)
+			return;
+		double increase = 100.0 * double(_after - _before) / double(_before);
+		bool regression = increase > _tolerance;
+		cerr << (regression ? "Regression" : "Slowdown within tolerance") << " in " << _name << ": ";
+		cerr << _metric << " " << _before << " -> " << _after << " (+" << unsigned(increase) << "%)" << endl;
+		if (regression)
+			success = false;
+	};
+
+	for (Json::Value const& benchmark: _results["benchmarks"])
+	{
+		auto key = make_pair(benchmark["corpus"].asString(), benchmark["settings"].asString());
+		if (!baseline.count(key))
+			continue;
+		Json::Value const& before = baseline[key];
+		string name = key.first + " (" + key.second + ")";
+		compare(name, "median time in us", before["time"]["median"].asUInt64(), benchmark["time"]["median"].asUInt64());
+		compare(name, "peak memory in bytes", before["peakMemory"].asUInt64(), benchmark["peakMemory"].asUInt64());
+	}
+	return success;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(solbench, benchmark of the compiler throughput.
+Usage: solbench [Options] [<directory> ...]
+Compiles all Solidity files below each directory (by default the subdirectories of
+test/compilationTests) and a generated contract under several optimizer settings and
+prints the wall time, peak memory, size of the creation bytecode and time per compiler
+phase as JSON. All times are in microseconds, memory and sizes are in bytes.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("corpus", po::value<vector<string>>(), "directory of the corpus")
+		(
+			"settings",
+			po::value<string>()->default_value("default,optimize,optimize-yul"),
+			"Comma-separated list of optimizer settings (default, optimize, optimize-yul or "
+			"yul:<steps> for the Yul optimizer with the given step sequence)."
+		)
+		("repetitions", po::value<unsigned>()->default_value(3), "Number of times each corpus is compiled.")
+		(
+			"generated",
+			po::value<unsigned>()->default_value(200),
+			"Number of functions in the generated contract, 0 to disable it."
+		)
+		(
+			"ast",
+			"Also benchmark the JSON AST export (settings \"ast-json\"). \"bytes\" is the size of the "
+			"output, \"valueTime\" the time when building JSON values first."
+		)
+		("jobs,j", po::value<unsigned>()->default_value(1), "Number of contracts compiled concurrently.")
+		("output,o", po::value<string>(), "Write the results to the given file instead of stdout.")
+		("baseline", po::value<string>(), "Results of an earlier run to compare against.")
+		(
+			"tolerance",
+			po::value<double>()->default_value(10),
+			"Percentage by which the results may be worse than the baseline."
+		)
+		("help", "Show this help screen.");
+
+	po::positional_options_description corpusPositions;
+	corpusPositions.add("corpus", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(corpusPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	unsigned repetitions = arguments["repetitions"].as<unsigned>();
+	if (repetitions == 0)
+	{
+		cerr << "The number of repetitions has to be positive." << endl;
+		return 1;
+	}
+
+	vector<string> settings;
+	boost::split(settings, arguments["settings"].as<string>(), boost::is_any_of(","));
+	for (string const& setting: settings)
+		if (!optimiserSettings(setting))
+		{
+			cerr << "Invalid optimizer settings: " << setting << endl;
+			return 1;
+		}
+
+	Json::Value baseline;
+	if (arguments.count("baseline"))
+	{
+		string baselineFile = arguments["baseline"].as<string>();
+		if (!jsonParseStrict(readFileAsString(baselineFile), baseline) || !baseline["benchmarks"].isArray())
+		{
+			cerr << "Invalid baseline: " << baselineFile << endl;
+			return 1;
+		}
+	}
+
+	vector<Corpus> corpora;
+	try
+	{
+		vector<fs::path> directories;
+		if (arguments.count("corpus"))
+			for (string const& directory: arguments["corpus"].as<vector<string>>())
+				directories.emplace_back(directory);
+		else
+			for (fs::directory_iterator it("test/compilationTests"), end; it != end; ++it)
+				if (fs::is_directory(it->path()))
+					directories.push_back(it->path());
+		sort(directories.begin(), directories.end());
+		for (fs::path const& directory: directories)
+			corpora.emplace_back(loadCorpus(directory));
+	}
+	catch (fs::filesystem_error const& _exception)
+	{
+		cerr << "Could not read the corpus: " << _exception.what() << endl;
+		return 1;
+	}
+	if (unsigned generated = arguments["generated"].as<unsigned>())
+		corpora.emplace_back(generatedCorpus(generated));
+
+	Json::Value results(Json::objectValue);
+	results["compilerVersion"] = VersionString;
+	results["repetitions"] = repetitions;
+	results["benchmarks"] = Json::arrayValue;
+	for (Corpus const& corpus: corpora)
+		for (string const& setting: settings)
+		{
+			cerr << "Compiling " << corpus.name << " (" << setting << ")..." << endl;
+			Json::Value benchmark = runBenchmark(
+				corpus,
+				setting,
+				*optimiserSettings(setting),
+				repetitions,
+				arguments["jobs"].as<unsigned>()
+			);
+			if (benchmark.isNull())
+				return 1;
+			results["benchmarks"].append(move(benchmark));
+		}
+	if (arguments.count("ast"))
+		for (Corpus const& corpus: corpora)
+		{
+			cerr << "Exporting the AST of " << corpus.name << "..." << endl;
+			Json::Value benchmark = runASTBenchmark(corpus, repetitions);
+			if (benchmark.isNull())
+				return 1;
+			results["benchmarks"].append(move(benchmark));
+		}
+
+	if (arguments.count("output"))
+	{
+		string outputFile = arguments["output"].as<string>();
+		ofstream output(outputFile);
+		output << jsonPrettyPrint(results) << endl;
+		if (!output)
+		{
+			cerr << "Could not write to file: " << outputFile << endl;
+			return 1;
+		}
+	}
+	else
+		cout << jsonPrettyPrint(results) << endl;
+
+	if (arguments.count("baseline") && !checkRegressions(results, baseline, arguments["tolerance"].as<double>()))
+		return 2;
+
+	return 0;
+}